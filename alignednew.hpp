@@ -0,0 +1,42 @@
+#pragma once
+
+#include "defines.hpp"
+
+#include <new>
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+// Before C++17 new only guarantees alignof(std::max_align_t), not enough for the classes with cache line aligned members
+inline void* cacheAlignedAlloc(size_t size)
+{
+#ifdef _WIN32
+	void* ptr(_aligned_malloc(size, CACHE_LINE_SIZE));
+#else
+	void* ptr(nullptr);
+
+	if (posix_memalign(&ptr, CACHE_LINE_SIZE, size) != 0)
+		ptr = nullptr;
+#endif
+
+	if (ptr == nullptr)
+		throw std::bad_alloc();
+
+	return ptr;
+}
+
+inline void cacheAlignedFree(void* ptr)
+{
+#ifdef _WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+// Put in the public part of a class that is allocated with new and contains cache line aligned members, directly or not
+#define CACHE_ALIGNED_NEW \
+	static void* operator new(size_t size) { return cacheAlignedAlloc(size); } \
+	static void operator delete(void* ptr) { cacheAlignedFree(ptr); }
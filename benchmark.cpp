@@ -0,0 +1,260 @@
+#include "benchmark.hpp"
+
+double benchmarkRun(uint64_t& cycles, uint64_t& instructions, Engine engine, bool coreOnly, bool printState);
+bool verifyProgram(uint64_t cycles, Engine engine, void (*loadProgram)(RAM*), std::string programName);
+void loadBenchmarkProgram(RAM* ramChip);
+void loadSelfModifyingProgram(RAM* ramChip);
+void printCPUState(CPU* cpuChip, std::string label);
+bool sameCPUState(CPU* cpuChip, CPU* referenceChip);
+std::string engineName(Engine engine);
+
+// Runs a busy loop mixing ALU, RAM, stack and jump instructions, and measures the emulated frequency
+void runBenchmark(uint64_t cycles, Engine engine)
+{
+	double elapsed(0.0), bestElapsed(0.0);
+	uint64_t executedCycles(0), instructions(0);
+
+	std::cout << "[BENCHMARK] : " << engineName(engine) << " engine" << std::endl;
+
+	for (unsigned int coreOnly(0); coreOnly <= 1; coreOnly++) // The whole computer first, then the CPU and the RAM alone
+	{
+		for (unsigned int run(1); run <= BENCHMARK_RUNS; run++)
+		{
+			executedCycles = cycles;
+			elapsed = benchmarkRun(executedCycles, instructions, engine, coreOnly, run == BENCHMARK_RUNS);
+
+			if (run == 1 || elapsed < bestElapsed)
+				bestElapsed = elapsed;
+
+			std::cout << "[BENCHMARK] : " << (coreOnly ? "CPU + RAM" : "Computer") << " run " << run << " : " << executedCycles << " cycles in " << elapsed << " s ("
+					  << (int)((double)executedCycles / elapsed / 1000.0) << " kHz, " << (int)((double)instructions / elapsed / 1000.0) << " thousand instructions per second)" << std::endl;
+		}
+
+		std::cout << "[BENCHMARK] : " << (coreOnly ? "CPU + RAM" : "Computer") << " best run : " << (uint64_t)((double)executedCycles / bestElapsed) << " cycles per second" << std::endl;
+	}
+}
+
+// Runs up to the first instruction boundary after the requested number of cycles, which is updated with the cycles actually run
+double benchmarkRun(uint64_t& cycles, uint64_t& instructions, Engine engine, bool coreOnly, bool printState)
+{
+	uint64_t executedCycles(0);
+
+	Machine* computer = new Machine(engine, new NullDisplay());
+	CPU* cpuChip(computer->getCPU());
+	RAM* ramChip(computer->getRAM());
+
+	loadBenchmarkProgram(ramChip);
+
+	std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+
+	if (!coreOnly) // Through the same batched API as the emulator itself
+	{
+		executedCycles = computer->run(cycles);
+		executedCycles += computer->runUntil([cpuChip] { return cpuChip->isAtInstructionBoundary(); });
+	}
+	else if (engine == Engine::BLOCKS || engine == Engine::JIT)
+	{
+		while (executedCycles < cycles)
+		{
+			executedCycles += cpuChip->runBlocks((unsigned int)std::min<uint64_t>(cycles - executedCycles, BLOCK_CHAIN_MAX_CYCLES), engine == Engine::JIT);
+		}
+	}
+	else if (engine == Engine::INTERPRETER) // Whole instructions, the RAM chip is accessed directly by the CPU
+	{
+		while (executedCycles < cycles)
+		{
+			executedCycles += cpuChip->step();
+		}
+	}
+	else // The program doesn't use any I/O port, so the CPU only needs the RAM to run it
+	{
+		while (executedCycles < cycles || !cpuChip->isAtInstructionBoundary())
+		{
+			cpuChip->tick();
+			ramChip->tick();
+			executedCycles++;
+		}
+	}
+
+	double elapsed(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+	cycles = executedCycles;
+	instructions = cpuChip->getInstructionsCount();
+
+	if (printState) // The final state must be the same whatever the engine, it is used to check it
+	{
+		printCPUState(cpuChip, "[BENCHMARK] : Final state");
+
+		if (cpuChip->getDecodeCache() != nullptr)
+			std::cout << "[BENCHMARK] : Decode cache : " << cpuChip->getDecodeCache()->getHits() << " hits | " << cpuChip->getDecodeCache()->getMisses() << " misses | "
+					  << cpuChip->getDecodeCache()->getInvalidations() << " invalidations" << std::endl;
+
+		if (cpuChip->getBlockCache() != nullptr)
+			std::cout << "[BENCHMARK] : Block cache : " << cpuChip->getBlockCache()->getHits() << " hits (" << cpuChip->getBlockCache()->getChainedHits() << " chained) | "
+					  << cpuChip->getBlockCache()->getTranslations() << " translations | " << cpuChip->getBlockCache()->getInvalidations() << " invalidations" << std::endl;
+	}
+
+	delete computer;
+
+	return elapsed;
+}
+
+bool runVerification(uint64_t cycles, Engine engine)
+{
+	bool benchmarkSame(verifyProgram(cycles, engine, loadBenchmarkProgram, "benchmark"));
+	bool selfModifyingSame(verifyProgram(cycles, engine, loadSelfModifyingProgram, "self-modifying")); // The benchmark program never writes over its code
+
+	return benchmarkSame && selfModifyingSame;
+}
+
+// The reference computer runs the code engine, and catches up with the other one after each of its steps
+bool verifyProgram(uint64_t cycles, Engine engine, void (*loadProgram)(RAM*), std::string programName)
+{
+	Motherboard* mb = new Motherboard();
+	CPU* cpuChip = new CPU(mb);
+	RAM* ramChip = new RAM(mb);
+	Motherboard* referenceMb = new Motherboard();
+	CPU* referenceChip = new CPU(referenceMb);
+	RAM* referenceRamChip = new RAM(referenceMb);
+	uint64_t executedCycles(0), instructions(0);
+	bool same(true), caughtUp(true);
+
+	loadProgram(ramChip);
+	loadProgram(referenceRamChip);
+
+	std::cout << "[VERIFY] : " << engineName(engine) << " engine against the microcode engine, " << programName << " program" << std::endl;
+
+	while (same && (executedCycles < cycles || !caughtUp))
+	{
+		if (engine == Engine::BLOCKS || engine == Engine::JIT)
+			executedCycles += cpuChip->runBlocks(BLOCK_CHAIN_MAX_CYCLES, engine == Engine::JIT);
+		else if (engine == Engine::INTERPRETER)
+			executedCycles += cpuChip->step();
+		else
+		{
+			do
+			{
+				cpuChip->tick();
+				ramChip->tick();
+				executedCycles++;
+			} while (!cpuChip->isAtInstructionBoundary());
+		}
+
+		caughtUp = (cpuChip->getInstructionsCount() != instructions || cpuChip->isHalted()); // Not after an interrupt entry, the reference only starts it while fetching its next instruction
+
+		if (!caughtUp)
+			continue;
+
+		instructions = cpuChip->getInstructionsCount();
+
+		while (referenceChip->getInstructionsCount() < instructions || !referenceChip->isAtInstructionBoundary())
+		{
+			referenceChip->tick();
+			referenceRamChip->tick();
+		}
+
+		same = sameCPUState(cpuChip, referenceChip);
+	}
+
+	if (same && memcmp(ramChip->getMemory(), referenceRamChip->getMemory(), RAM_SIZE) != 0)
+	{
+		std::cout << "[VERIFY] : The RAM contents differ" << std::endl;
+		same = false;
+	}
+
+	if (same)
+		std::cout << "[VERIFY] : " << cpuChip->getInstructionsCount() << " instructions (" << executedCycles << " cycles) without any difference" << std::endl;
+	else
+	{
+		std::cout << "[VERIFY] : Difference after " << cpuChip->getInstructionsCount() << " instructions" << std::endl;
+		printCPUState(cpuChip, "[VERIFY] : " + engineName(engine));
+		printCPUState(referenceChip, "[VERIFY] : Microcode");
+	}
+
+	delete cpuChip; // Before the RAM chips, the CPU caches are listening to their writes
+	delete ramChip;
+	delete mb;
+	delete referenceChip;
+	delete referenceRamChip;
+	delete referenceMb;
+
+	return same;
+}
+
+void loadBenchmarkProgram(RAM* ramChip)
+{
+	ramChip->set5bData(0x7880000000, BENCHMARK_PROGRAM_ADDRESS);      // MOV A, 0x00
+	ramChip->set5bData(0x0880030000, BENCHMARK_PROGRAM_ADDRESS + 5);  // ADD A, 0x03 (loop start)
+	ramChip->set5bData(0x0448000000, BENCHMARK_PROGRAM_ADDRESS + 10); // ADC B, A
+	ramChip->set5bData(0xBC51000000, BENCHMARK_PROGRAM_ADDRESS + 15); // XOR C, B
+	ramChip->set5bData(0x70C0008000, BENCHMARK_PROGRAM_ADDRESS + 20); // STR A, $0x008000
+	ramChip->set5bData(0x08D8008000, BENCHMARK_PROGRAM_ADDRESS + 25); // ADD D, $0x008000
+	ramChip->set5bData(0x8858000000, BENCHMARK_PROGRAM_ADDRESS + 30); // PSH D
+	ramChip->set5bData(0x118000C000, BENCHMARK_PROGRAM_ADDRESS + 35); // CAL 0x00C000
+	ramChip->set5bData(0x8468000000, BENCHMARK_PROGRAM_ADDRESS + 40); // POP J
+	ramChip->set5bData(0x4580008001, BENCHMARK_PROGRAM_ADDRESS + 45); // INC $0x008001
+	ramChip->set5bData(0x6180000405, BENCHMARK_PROGRAM_ADDRESS + 50); // JMP 0x000405
+
+	ramChip->set5bData(0x7872000000, BENCHMARK_SUBROUTINE_ADDRESS);      // MOV X, C
+	ramChip->set5bData(0x9070000000, BENCHMARK_SUBROUTINE_ADDRESS + 5);  // SHL X
+	ramChip->set5bData(0x30B0100000, BENCHMARK_SUBROUTINE_ADDRESS + 10); // CMP X, 0x10
+	ramChip->set5bData(0x8C00000000, BENCHMARK_SUBROUTINE_ADDRESS + 15); // RET
+}
+
+// Rewrites the address of an instruction wrapping around the end of the address space, and the immediate of an instruction of its own block
+void loadSelfModifyingProgram(RAM* ramChip)
+{
+	ramChip->set5bData(0x4580000002, BENCHMARK_PROGRAM_ADDRESS);      // INC $0x000002 (loop start)
+	ramChip->set5bData(0x0898010000, BENCHMARK_PROGRAM_ADDRESS + 5);  // ADD D, 0x01
+	ramChip->set5bData(0x4580000407, BENCHMARK_PROGRAM_ADDRESS + 10); // INC $0x000407, the immediate of the ADD above
+	ramChip->set5bData(0x6180FFFFFE, BENCHMARK_PROGRAM_ADDRESS + 15); // JMP 0xFFFFFE
+
+	ramChip->setData(0x08, 0xFFFFFE); // ADD C, $0x000500, its address is in the first bytes of the RAM
+	ramChip->setData(0xD0, 0xFFFFFF);
+	ramChip->setData(0x05, 0x000001); // The program counter wraps around to a NOP
+	ramChip->set5bData(0x6180000400, 0x000005); // JMP 0x000400
+
+	for (uint32_t i(0); i < 0x100; i++) // Table read by the ADD
+	{
+		ramChip->setData((uint8_t)(i * 7 + 1), 0x000500 + i);
+	}
+}
+
+void printCPUState(CPU* cpuChip, std::string label)
+{
+	std::cout << label << " : PC 0x" << uintToString(cpuChip->getProgramCounter()) << " | SP 0x" << uintToString(cpuChip->getStackPointer())
+			  << " | A 0x" << uintToString(cpuChip->getRegA()) << " | B 0x" << uintToString(cpuChip->getRegB())
+			  << " | C 0x" << uintToString(cpuChip->getRegC()) << " | D 0x" << uintToString(cpuChip->getRegD())
+			  << " | I 0x" << uintToString(cpuChip->getRegI()) << " | J 0x" << uintToString(cpuChip->getRegJ())
+			  << " | X 0x" << uintToString(cpuChip->getRegX()) << " | Y 0x" << uintToString(cpuChip->getRegY())
+			  << " | Flags " << cpuChip->getFlagsRegister() << " | " << cpuChip->getInstructionsCount() << " instructions" << std::endl;
+}
+
+bool sameCPUState(CPU* cpuChip, CPU* referenceChip)
+{
+	return cpuChip->getProgramCounter() == referenceChip->getProgramCounter() && cpuChip->getStackPointer() == referenceChip->getStackPointer()
+		&& cpuChip->getRegA() == referenceChip->getRegA() && cpuChip->getRegB() == referenceChip->getRegB()
+		&& cpuChip->getRegC() == referenceChip->getRegC() && cpuChip->getRegD() == referenceChip->getRegD()
+		&& cpuChip->getRegI() == referenceChip->getRegI() && cpuChip->getRegJ() == referenceChip->getRegJ()
+		&& cpuChip->getRegX() == referenceChip->getRegX() && cpuChip->getRegY() == referenceChip->getRegY()
+		&& cpuChip->getAcc1() == referenceChip->getAcc1() && cpuChip->getAcc2() == referenceChip->getAcc2() && cpuChip->getAluOut() == referenceChip->getAluOut()
+		&& cpuChip->getFlags() == referenceChip->getFlags() && cpuChip->getInstructionsCount() == referenceChip->getInstructionsCount();
+}
+
+std::string engineName(Engine engine)
+{
+	switch (engine)
+	{
+	case Engine::INTERPRETER:
+		return "Interpreter";
+
+	case Engine::BLOCKS:
+		return "Blocks";
+
+	case Engine::JIT:
+		return "JIT";
+
+	default:
+		return "Microcode";
+	}
+}
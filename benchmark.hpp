@@ -0,0 +1,12 @@
+#pragma once
+
+#include "machine.hpp"
+
+#define BENCHMARK_DEFAULT_CYCLES 20000000
+#define BENCHMARK_RUNS 3
+
+#define BENCHMARK_PROGRAM_ADDRESS WORK_MEMORY_START_ADDRESS
+#define BENCHMARK_SUBROUTINE_ADDRESS 0x00C000
+
+void runBenchmark(uint64_t cycles, Engine engine);
+bool runVerification(uint64_t cycles, Engine engine); // Runs the benchmark program, then a self-modifying one, with both engines in lockstep, returns false at the first difference
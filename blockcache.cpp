@@ -0,0 +1,235 @@
+#include "blockcache.hpp"
+
+BlockCache::BlockCache(RAM* ram)
+{
+	m_ram = ram;
+	m_lastBlock = nullptr;
+
+	m_hits = 0;
+	m_chainedHits = 0;
+	m_translations = 0;
+	m_invalidations = 0;
+
+	m_ram->addWriteListener(this);
+}
+
+BlockCache::~BlockCache()
+{
+	m_ram->removeWriteListener(this);
+
+	flush();
+	deleteRetiredBlocks();
+}
+
+Block* BlockCache::lookup(uint32_t address)
+{
+	deleteRetiredBlocks(); // No block is running anymore
+
+	if (m_lastBlock != nullptr)
+	{
+		for (unsigned int i(0); i < BLOCK_LINKS_NB; i++)
+		{
+			if (m_lastBlock->links[i] != nullptr && m_lastBlock->links[i]->address == address)
+			{
+				m_lastBlock = m_lastBlock->links[i];
+				m_hits++;
+				m_chainedHits++;
+
+				return m_lastBlock;
+			}
+		}
+	}
+
+	std::unordered_map<uint32_t, Block*>::iterator it(m_blocks.find(address));
+
+	if (it == m_blocks.end())
+		return nullptr;
+
+	link(m_lastBlock, it->second);
+	m_lastBlock = it->second;
+	m_hits++;
+
+	return m_lastBlock;
+}
+
+Block* BlockCache::insert(Block* block)
+{
+	block->valid = true;
+	block->runs = 0;
+	block->code = nullptr;
+	block->jitCycles = 0;
+
+	for (unsigned int i(0); i < BLOCK_LINKS_NB; i++)
+	{
+		block->links[i] = nullptr;
+	}
+
+	block->predecessors.clear();
+	m_blocks[block->address] = block;
+
+	for (uint32_t page(block->address / RAM_PAGE_SIZE); page <= (block->endAddress - 1) / RAM_PAGE_SIZE; page++) // The last instruction may wrap around to the first page
+	{
+		m_pageBlocks[page & (RAM_PAGES_NB - 1)].push_back(block);
+		m_ram->watchPage((page & (RAM_PAGES_NB - 1)) * RAM_PAGE_SIZE);
+	}
+
+	link(m_lastBlock, block);
+	m_lastBlock = block;
+	m_translations++;
+
+	return block;
+}
+
+void BlockCache::flush()
+{
+	for (std::unordered_map<uint32_t, Block*>::iterator it(m_blocks.begin()); it != m_blocks.end(); it++)
+	{
+		it->second->valid = false;
+		m_retiredBlocks.push_back(it->second); // May still be running
+	}
+
+	m_blocks.clear();
+	m_pageBlocks.clear();
+	m_lastBlock = nullptr;
+}
+
+void BlockCache::onMemoryWrite(uint32_t address)
+{
+	std::unordered_map<uint32_t, std::vector<Block*>>::iterator it(m_pageBlocks.find(address / RAM_PAGE_SIZE));
+
+	if (it == m_pageBlocks.end())
+		return;
+
+	std::vector<Block*> overwrittenBlocks;
+
+	for (unsigned int i(0); i < it->second.size(); i++)
+	{
+		if (((address - it->second[i]->address) & 0x00FFFFFF) < it->second[i]->endAddress - it->second[i]->address) // Also holds for the bytes of a wrapping instruction
+			overwrittenBlocks.push_back(it->second[i]);
+	}
+
+	for (unsigned int i(0); i < overwrittenBlocks.size(); i++)
+	{
+		invalidate(overwrittenBlocks[i]);
+	}
+}
+
+// GETTERS
+uint64_t BlockCache::getHits()
+{
+	return m_hits;
+}
+
+uint64_t BlockCache::getChainedHits()
+{
+	return m_chainedHits;
+}
+
+uint64_t BlockCache::getTranslations()
+{
+	return m_translations;
+}
+
+uint64_t BlockCache::getInvalidations()
+{
+	return m_invalidations;
+}
+
+// PRIVATE
+void BlockCache::link(Block* from, Block* to)
+{
+	if (from == nullptr)
+		return;
+
+	for (unsigned int i(0); i < BLOCK_LINKS_NB; i++)
+	{
+		if (from->links[i] == to)
+			return;
+	}
+
+	for (unsigned int i(0); i < BLOCK_LINKS_NB; i++)
+	{
+		if (from->links[i] == nullptr) // The links of an invalidated successor are cleared, the free slot may not be the last one
+		{
+			from->links[i] = to;
+			to->predecessors.push_back(from);
+			return;
+		}
+	}
+
+	removePredecessor(from->links[BLOCK_LINKS_NB - 1], from); // Indirect jumps may have more successors, the last one is replaced
+	from->links[BLOCK_LINKS_NB - 1] = to;
+	to->predecessors.push_back(from);
+}
+
+void BlockCache::removePredecessor(Block* block, Block* predecessor)
+{
+	for (unsigned int i(0); i < block->predecessors.size(); i++)
+	{
+		if (block->predecessors[i] == predecessor)
+		{
+			block->predecessors[i] = block->predecessors.back(); // The order doesn't matter
+			block->predecessors.pop_back();
+			return;
+		}
+	}
+}
+
+void BlockCache::invalidate(Block* block)
+{
+	block->valid = false;
+	m_invalidations++;
+
+	m_blocks.erase(block->address);
+
+	for (uint32_t page(block->address / RAM_PAGE_SIZE); page <= (block->endAddress - 1) / RAM_PAGE_SIZE; page++)
+	{
+		std::vector<Block*>& pageBlocks(m_pageBlocks[page & (RAM_PAGES_NB - 1)]);
+
+		for (unsigned int i(0); i < pageBlocks.size(); i++)
+		{
+			if (pageBlocks[i] == block)
+			{
+				pageBlocks.erase(pageBlocks.begin() + i);
+				break;
+			}
+		}
+	}
+
+	for (unsigned int i(0); i < block->predecessors.size(); i++) // Nobody must chain to it anymore
+	{
+		Block* predecessor(block->predecessors[i]);
+
+		for (unsigned int j(0); j < BLOCK_LINKS_NB; j++)
+		{
+			if (predecessor->links[j] == block)
+				predecessor->links[j] = nullptr;
+		}
+	}
+
+	block->predecessors.clear();
+
+	for (unsigned int i(0); i < BLOCK_LINKS_NB; i++) // Nor be listed as a predecessor once deleted
+	{
+		if (block->links[i] != nullptr)
+		{
+			removePredecessor(block->links[i], block);
+			block->links[i] = nullptr;
+		}
+	}
+
+	if (m_lastBlock == block)
+		m_lastBlock = nullptr;
+
+	m_retiredBlocks.push_back(block); // It may be the block currently running, which has just overwritten itself
+}
+
+void BlockCache::deleteRetiredBlocks()
+{
+	for (unsigned int i(0); i < m_retiredBlocks.size(); i++)
+	{
+		delete m_retiredBlocks[i];
+	}
+
+	m_retiredBlocks.clear();
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "defines.hpp"
+#include "ram.hpp"
+#include "decodecache.hpp"
+
+#define BLOCK_MAX_INSTRUCTIONS 64
+#define BLOCK_CHAIN_MAX_CYCLES 1024 // Cycles run through chained blocks before giving the devices a tick
+#define BLOCK_LINKS_NB 2 // Taken and not taken successors of the final jump
+
+// Straight-line run of instructions, ending with a jump, a call, a return, an interrupt, a halt, an I/O access or a STI
+typedef struct Block
+{
+	uint32_t address;
+	uint32_t endAddress; // First byte after the block, past WORK_MEMORY_END_ADDRESS when the last instruction wraps around
+
+	std::vector<DecodedInstruction> instructions;
+
+	bool valid; // False once overwritten, the block is deleted as soon as it doesn't run anymore
+	struct Block* links[BLOCK_LINKS_NB]; // Successors already met, followed without any lookup
+	std::vector<struct Block*> predecessors; // Blocks with a link to this one, once per link, unlinked when it is invalidated
+
+	unsigned int runs;
+	void* code; // Native code of the compiled instructions, nullptr if the block isn't compiled
+	unsigned int jitCycles; // Cycles spent by the compiled instructions
+} Block;
+
+// Translated blocks, invalidated by the RAM writes over their instructions
+class BlockCache : public MemoryWriteListener
+{
+	public:
+		BlockCache(RAM* ram);
+		~BlockCache();
+
+		Block* lookup(uint32_t address); // nullptr if no block starts at this address, the successors of the last block are checked first
+		Block* insert(Block* block); // Takes the ownership of the block
+		void flush();
+
+		void onMemoryWrite(uint32_t address);
+
+		// Getters
+		uint64_t getHits();
+		uint64_t getChainedHits();
+		uint64_t getTranslations();
+		uint64_t getInvalidations();
+
+	private:
+		void link(Block* from, Block* to);
+		void removePredecessor(Block* block, Block* predecessor);
+		void invalidate(Block* block);
+		void deleteRetiredBlocks();
+
+		RAM* m_ram;
+
+		std::unordered_map<uint32_t, Block*> m_blocks; // By start address
+		std::unordered_map<uint32_t, std::vector<Block*>> m_pageBlocks; // Blocks overlapping each RAM page
+		std::vector<Block*> m_retiredBlocks;
+		Block* m_lastBlock;
+
+		uint64_t m_hits;
+		uint64_t m_chainedHits;
+		uint64_t m_translations;
+		uint64_t m_invalidations;
+};
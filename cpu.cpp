@@ -1,4 +1,17 @@
 #include "cpu.hpp"
+#include "logger.hpp"
+
+// instructions dispatch : one jump through a table of labels when the compiler supports it, a switch otherwise
+#ifdef CODE_COMPUTED_GOTO
+#define HANDLER_LABEL(handler) &&handler_##handler,
+#define DISPATCH(handler) static const void* const handlerLabels[] = {HANDLERS(HANDLER_LABEL)}; goto *handlerLabels[(int)(handler)];
+#define HANDLER(handler) handler_##handler
+#else
+#define DISPATCH(handler) switch (handler)
+#define HANDLER(handler) case handlersList::handler
+#endif
+
+#define NEXT return // Nothing left to do in tick() once the instruction is executed
 
 // TODO : Carry flag when stack overflow
 
@@ -12,21 +25,13 @@ CPU::CPU(Motherboard* mb)
 	}
 	m_interruptData = 0x00;
 
-	m_flags.CARRY = false;
-	m_flags.EQUAL = false;
-	m_flags.HALT = false;
-	m_flags.INFERIOR = false;
-	m_flags.INTERRUPT = false;
-	m_flags.NEGATIVE = false;
-	m_flags.SUPERIOR = false;
-	m_flags.ZERO = false;
-
-	initcode();
+	m_flags = 0x00;
+	m_pendingFlags = {FlagsUpdate::NONE, 0, 0, 0};
 
 	m_aluOut = 0;
 	m_accu1 = 0;
 	m_accu2 = 0;
-	m_flags.INTERRUPT = true; // Interrupt flag up by default, CPU ready to handle interrupts
+	m_flags |= FLAG_INTERRUPT; // Interrupt flag up by default, CPU ready to handle interrupts
 	m_programCounter = WORK_MEMORY_START_ADDRESS;
 	m_stackPointer = STACK_START_ADDRESS;
 	m_softwareInterrupt = false;
@@ -34,6 +39,8 @@ CPU::CPU(Motherboard* mb)
 	m_fetchedInstruction = 0;
 	m_opcode = 0;
 	m_addressingMode = 0;
+	m_codeStart = 0;
+	m_codeLength = 0;
 	m_R1 = nullptr;
 	m_R2 = nullptr;
 	m_R3 = nullptr;
@@ -46,24 +53,35 @@ CPU::CPU(Motherboard* mb)
 	m_interruptVector = 0;
 	m_interruptPort = 0;
 	m_dataBusValue = 0;
-	m_pointedRegister = nullptr;
-	m_valueToStore = nullptr;
+
+	m_instructionsCount = 0;
+	m_decodeCache = nullptr;
+	m_blockCache = nullptr;
+	m_jitBuffer = nullptr;
 
 	m_jump = false;
 	m_step = Step::FETCH_1;
 	m_codeStep = 0;
 }
 
+CPU::~CPU()
+{
+	delete m_decodeCache;
+	delete m_blockCache;
+	delete m_jitBuffer;
+}
+
 void CPU::tick()
 {
-	if (m_flags.HALT)
+	if (m_flags & FLAG_HALT)
 	{
-		m_flags.INTERRUPT = true; // CPU always ready to handle interrupts when halted (otherwise, no way to get out of the interrupt)
+		m_flags |= FLAG_INTERRUPT; // CPU always ready to handle interrupts when halted (otherwise, no way to get out of the interrupt)
 
-		if (m_step != Step::FETCH_1)
+		if (m_step != Step::FETCH_1) // End of the HLT instruction
 		{
 			m_step = Step::FETCH_1;
 			m_codeStep = 0; // Safety feature
+			m_instructionsCount++;
 
 			m_programCounter += 5;
 			if (m_programCounter >= WORK_MEMORY_END_ADDRESS)
@@ -74,7 +92,7 @@ void CPU::tick()
 			m_step = Step::INTERRUPT_1;
 
 			m_mb->setINR(true); // Needless to check if it is a software interrupt, since the CPU is currently halted
-			m_flags.HALT = false;
+			m_flags &= ~FLAG_HALT;
 		}
 	}
 	else
@@ -84,11 +102,11 @@ void CPU::tick()
 		case Step::INTERRUPT_1:
 			m_mb->setINR(false);
 
-			m_flags.INTERRUPT = false; // CPU unable to handle new interrupts from this point (until IRT instruction is reached, or if the programmer uses instruction STI before IRT)
+			m_flags &= ~FLAG_INTERRUPT; // CPU unable to handle new interrupts from this point (until IRT instruction is reached, or if the programmer uses instruction STI before IRT)
 
 			m_interruptPort = (uint8_t)(m_mb->getAddressBus() & 0x000000FF);
 			m_interruptData = m_mb->getDataBus(); // Done here so the IOD chip hasn't time to change the data bus value (for the next interrupt if there is any)
-			std::cout << "Interrupt data : " << uintToString(m_interruptData) << std::endl;
+			LOG_DEBUG("CPU", "Interrupt data : " << uintToString(m_interruptData));
 
 			_movAddBus(m_stackPointer); // Pushing less significant byte of program counter in the stack
 			_movDataBus((uint8_t)(m_programCounter & 0x000000FF));
@@ -168,7 +186,7 @@ void CPU::tick()
 			break;
 
 		case Step::FETCH_1:
-			if (m_flags.INTERRUPT && (m_mb->getINT() || m_softwareInterrupt)) // An interrupt has been triggered and the CPU is ready to handle it
+			if ((m_flags & FLAG_INTERRUPT) && (m_mb->getINT() || m_softwareInterrupt)) // An interrupt has been triggered and the CPU is ready to handle it
 			{
 				m_step = Step::INTERRUPT_1;
 				
@@ -235,17 +253,7 @@ void CPU::tick()
 			// VI : Save byte 5 of the next instruction and decode it (opcode, addressing mode, operands)
 			m_fetchedInstruction += m_mb->getDataBus();
 
-			m_opcode = (uint8_t)((m_fetchedInstruction & 0xFC00000000) >> 34);
-			m_addressingMode = (uint8_t)((m_fetchedInstruction & 0x03C0000000) >> 30);
-			m_R1 = &m_registers[(m_fetchedInstruction & 0x0038000000) >> 27];
-			m_R2 = &m_registers[(m_fetchedInstruction & 0x0007000000) >> 24];
-			m_V1 = (uint8_t)((m_fetchedInstruction & 0x0000FF0000) >> 16);
-			m_V2 = (m_fetchedInstruction & 0x000000FF00) >> 8;
-			m_Ex = m_fetchedInstruction & 0x00000000FF;
-			m_Vx = ((uint32_t)(m_V1) << 16) + ((uint32_t)(m_V2) << 8) + (uint32_t)(m_Ex);
-			m_R3 = &m_registers[m_V1 & 0x07];
-			m_R4 = &m_registers[m_Ex & 0x07];
-			m_Rx = ((uint32_t)(*m_R1) << 16) + ((uint32_t)(*m_R2) << 8) + (uint32_t)(*m_R3);
+			decode();
 
 			m_step = Step::EXECUTE;
 			m_codeStep = 0;
@@ -256,10 +264,11 @@ void CPU::tick()
 			// VII : Execute the instruction
 			m_dataBusValue = m_mb->getDataBus();
 
-			if (m_codeStep >= m_instructionsUCode[m_opcode].addrMode[m_addressingMode].size()) // Instruction fully executed
+			if (m_codeStep >= m_codeLength) // Instruction fully executed
 			{
 				m_step = Step::FETCH_1;
 				m_codeStep = 0; // Safety feature
+				m_instructionsCount++;
 
 				if (!m_jump)
 				{
@@ -272,460 +281,440 @@ void CPU::tick()
 			}
 			else // code to execute
 			{
-				m_code = m_instructionsUCode[m_opcode].addrMode[m_addressingMode].at(m_codeStep).uopcode;
-				std::vector<operandsList> operands = m_instructionsUCode[m_opcode].addrMode[m_addressingMode].at(m_codeStep).uoperands;
+				const uint16_t address(m_codeStart + m_codeStep);
+
+				m_codeStep++; // Before the dispatch, since the handlers return from tick() directly
+				m_code = codeROM.rom[address].uopcode; // Only kept for the display, the operands are already resolved in the handler
 
-				switch (m_code)
+				DISPATCH(codeROM.handlers[address])
 				{
-				case opcodesList::ADC:
+				HANDLER(NOP): // Operands without any effect
+					NEXT;
+
+				HANDLER(ADC):
 					_adc();
-					break;
+					NEXT;
 
-				case opcodesList::ADD:
+				HANDLER(ADD):
 					_add();
-					break;
+					NEXT;
 
-				case opcodesList::SUB:
+				HANDLER(SUB):
 					_sub();
-					break;
+					NEXT;
 
-				case opcodesList::AND:
+				HANDLER(AND):
 					_and();
-					break;
+					NEXT;
 
-				case opcodesList::XOR:
+				HANDLER(XOR):
 					_xor();
-					break;
+					NEXT;
 
-				case opcodesList::NOT:
+				HANDLER(NOT):
 					_not();
-					break;
+					NEXT;
 
-				case opcodesList::OR:
+				HANDLER(OR):
 					_or();
-					break;
+					NEXT;
 
-				case opcodesList::SHR:
+				HANDLER(SHR):
 					_shr();
-					break;
+					NEXT;
 
-				case opcodesList::ASR:
+				HANDLER(ASR):
 					_asr();
-					break;
+					NEXT;
 
-				case opcodesList::SHL:
+				HANDLER(SHL):
 					_shl();
-					break;
+					NEXT;
 
-				case opcodesList::CMP:
+				HANDLER(CMP):
 					_cmp();
-					break;
+					NEXT;
 
-				case opcodesList::IN:
+				HANDLER(IN):
 					_in();
-					break;
+					NEXT;
 
-				case opcodesList::OUT:
+				HANDLER(OUT):
 					_out();
-					break;
+					NEXT;
 
-				case opcodesList::INT:
+				HANDLER(INT):
 					_interrupt();
-					break;
+					NEXT;
 
-				case opcodesList::CLC:
+				HANDLER(CLC):
 					_clc();
-					break;
+					NEXT;
 
-				case opcodesList::CLE:
+				HANDLER(CLE):
 					_cle();
-					break;
+					NEXT;
 
-				case opcodesList::CLI:
+				HANDLER(CLI):
 					_cli();
-					break;
+					NEXT;
 
-				case opcodesList::CLN:
+				HANDLER(CLN):
 					_cln();
-					break;
+					NEXT;
 
-				case opcodesList::CLS:
+				HANDLER(CLS):
 					_cls();
-					break;
+					NEXT;
 
-				case opcodesList::CLZ:
+				HANDLER(CLZ):
 					_clz();
-					break;
+					NEXT;
 
-				case opcodesList::CLF:
+				HANDLER(CLF):
 					_clf();
-					break;
+					NEXT;
 
-				case opcodesList::STH:
+				HANDLER(STH):
 					_sth();
-					break;
+					NEXT;
 
-				case opcodesList::STC:
+				HANDLER(STC):
 					_stc();
-					break;
+					NEXT;
 
-				case opcodesList::STI:
+				HANDLER(STI):
 					_sti();
-					break;
+					NEXT;
 
-				case opcodesList::STN:
+				HANDLER(STN):
 					_stn();
-					break;
+					NEXT;
 
-				case opcodesList::STF:
+				HANDLER(STF):
 					_stf();
-					break;
+					NEXT;
 
-				case opcodesList::STS:
+				HANDLER(STS):
 					_sts();
-					break;
+					NEXT;
 
-				case opcodesList::STE:
+				HANDLER(STE):
 					_ste();
-					break;
+					NEXT;
 
-				case opcodesList::STZ:
+				HANDLER(STZ):
 					_stz();
-					break;
+					NEXT;
 
-				case opcodesList::DECSTK:
+				HANDLER(DECSTK):
 					_decSTK();
-					break;
+					NEXT;
 
-				case opcodesList::INCSTK:
+				HANDLER(INCSTK):
 					_incSTK();
-					break;
+					NEXT;
 
-				case opcodesList::INCPC:
+				HANDLER(INCPC):
 					_incPC();
-					break;
+					NEXT;
 
-				case opcodesList::RAMREAD:
+				HANDLER(RAMREAD):
 					_ramRead();
-					break;
+					NEXT;
 
-				case opcodesList::RAMWRITE:
+				HANDLER(RAMWRITE):
 					_ramWrite();
-					break;
-
-				case opcodesList::MOVACC1:
-					switch (operands[0])
-					{
-						case operandsList::ALUOUT:
-							_movAcc1(m_aluOut);
-							break;
-
-						case operandsList::DATABUS:
-							_movAcc1(m_mb->getDataBus());
-							break;
-
-						case operandsList::R1:
-							_movAcc1(*m_R1);
-							break;
-
-						case operandsList::R2:
-							_movAcc1(*m_R2);
-							break;
-
-						case operandsList::R4:
-							_movAcc1(*m_R4);
-							break;
-
-						case operandsList::V1:
-							_movAcc1(m_V1);
-							break;
-					}
-					break;
-
-				case opcodesList::MOVACC2:
-					switch (operands[0])
-					{
-						case operandsList::X1:
-							_movAcc2(0x1);
-							break;
-
-						case operandsList::ALUOUT:
-							_movAcc2(m_aluOut);
-							break;
-
-						case operandsList::DATABUS:
-							_movAcc2(m_mb->getDataBus());
-							break;
-
-						case operandsList::R1:
-							_movAcc2(*m_R1);
-							break;
-
-						case operandsList::R2:
-							_movAcc2(*m_R2);
-							break;
-
-						case operandsList::R4:
-							_movAcc2(*m_R4);
-							break;
-
-						case operandsList::V1:
-							_movAcc2(m_V1);
-							break;
-					}
-					break;
-
-				case opcodesList::MOVREG:
-					m_pointedRegister = nullptr;
-					m_valueToStore = nullptr;
-
-					switch (operands[0])
-					{
-						case operandsList::R1:
-							m_pointedRegister = m_R1;
-							break;
-
-						case operandsList::R2:
-							m_pointedRegister = m_R2;
-							break;
-
-						case operandsList::R4:
-							m_pointedRegister = m_R4;
-							break;
-
-						case operandsList::I:
-							m_pointedRegister = &m_registers[(int)Registers::I];
-							break;
-					}
-
-					switch (operands[1])
-					{
-						case operandsList::ALUOUT:
-							m_valueToStore = &m_aluOut;
-							break;
-
-						case operandsList::DATABUS:
-							m_valueToStore = &m_dataBusValue;
-							break;
-
-						case operandsList::R1:
-							m_valueToStore = m_R1;
-							break;
-
-						case operandsList::R2:
-							m_valueToStore = m_R2;
-							break;
-
-						case operandsList::R4:
-							m_valueToStore = m_R4;
-							break;
-
-						case operandsList::V1:
-							m_valueToStore = &m_V1;
-							break;
-					}
-
-					if (m_pointedRegister != nullptr && m_valueToStore != nullptr)
-						_movReg(m_pointedRegister, m_valueToStore);
-					break;
-
-				case opcodesList::MOVDATABUS:
-					switch (operands[0])
-					{
-						case operandsList::ALUOUT:
-							_movDataBus(m_aluOut);
-							break;
-
-						case operandsList::R1:
-							_movDataBus(*m_R1);
-							break;
-
-						case operandsList::R2:
-							_movDataBus(*m_R2);
-							break;
-
-						case operandsList::R4:
-							_movDataBus(*m_R4);
-							break;
-
-						case operandsList::V1:
-							_movDataBus(m_V1);
-							break;
-
-						case operandsList::PC_16:
-							_movDataBus((uint8_t)((m_programCounter & 0xFF0000) >> 16));
-							break;
-
-						case operandsList::PC_8:
-							_movDataBus((uint8_t)((m_programCounter & 0x00FF00) >> 8));
-							break;
-
-						case operandsList::PC8:
-							_movDataBus((uint8_t)(m_programCounter & 0x0000FF));
-							break;
-					}
-					break;
-
-				case opcodesList::MOVADDBUS:
-					switch (operands[0])
-					{
-						case operandsList::V1:
-							_movAddBus(m_V1);
-							break;
-
-						case operandsList::R1:
-							_movAddBus(*m_R1);
-							break;
-
-						case operandsList::R2:
-							_movAddBus(*m_R2);
-							break;
-
-						case operandsList::RX:
-							_movAddBus(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_movAddBus(m_Vx);
-							break;
-
-						case operandsList::STK:
-							_movAddBus(m_stackPointer);
-							break;
-						}
-					break;
-
-				case opcodesList::MOVPC:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_movPC(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_movPC(m_Vx);
-							break;
-
-						case operandsList::DATABUS16:
-							_movPC(m_mb->getDataBus() << 16);
-							break;
-
-						case operandsList::PCDATABUS8:
-							_movPC((m_mb->getDataBus() << 8) + m_programCounter);
-							break;
-
-						case operandsList::PCDATABUS:
-							_movPC(m_mb->getDataBus() + m_programCounter);
-							break;
-					}
-					break;
-
-				case opcodesList::JMC:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jmc(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jmc(m_Vx);
-							break;
-					}
-					break;
-
-				case opcodesList::JME:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jme(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jme(m_Vx);
-							break;
-					}
-					break;
-
-				case opcodesList::JMF:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jmf(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jmf(m_Vx);
-							break;
-					}
-					break;
-
-				case opcodesList::JMK:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jmk(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jmk(m_Vx);
-							break;
-					}
-					break;
-
-				case opcodesList::JMP:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jmp(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jmp(m_Vx);
-							break;
-					}
-					break;
-
-				case opcodesList::JMS:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jms(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jms(m_Vx);
-							break;
-					}
-					break;
-
-				case opcodesList::JMZ:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jmz(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jmz(m_Vx);
-							break;
-					}
-					break;
-
-				case opcodesList::JMN:
-					switch (operands[0])
-					{
-						case operandsList::RX:
-							_jmn(m_Rx);
-							break;
-
-						case operandsList::VX:
-							_jmn(m_Vx);
-							break;
-					}
-					break;
-				}
+					NEXT;
+
+				HANDLER(MOVACC1_ALUOUT):
+					_movAcc1(m_aluOut);
+					NEXT;
+
+				HANDLER(MOVACC1_DATABUS):
+					_movAcc1(m_mb->getDataBus());
+					NEXT;
+
+				HANDLER(MOVACC1_R1):
+					_movAcc1(*m_R1);
+					NEXT;
+
+				HANDLER(MOVACC1_R2):
+					_movAcc1(*m_R2);
+					NEXT;
+
+				HANDLER(MOVACC1_R4):
+					_movAcc1(*m_R4);
+					NEXT;
+
+				HANDLER(MOVACC1_V1):
+					_movAcc1(m_V1);
+					NEXT;
+
+				HANDLER(MOVACC2_X1):
+					_movAcc2(0x1);
+					NEXT;
+
+				HANDLER(MOVACC2_ALUOUT):
+					_movAcc2(m_aluOut);
+					NEXT;
+
+				HANDLER(MOVACC2_DATABUS):
+					_movAcc2(m_mb->getDataBus());
+					NEXT;
+
+				HANDLER(MOVACC2_R1):
+					_movAcc2(*m_R1);
+					NEXT;
+
+				HANDLER(MOVACC2_R2):
+					_movAcc2(*m_R2);
+					NEXT;
+
+				HANDLER(MOVACC2_R4):
+					_movAcc2(*m_R4);
+					NEXT;
+
+				HANDLER(MOVACC2_V1):
+					_movAcc2(m_V1);
+					NEXT;
+
+				HANDLER(MOVREG_R1_ALUOUT):
+					_movReg(m_R1, &m_aluOut);
+					NEXT;
+
+				HANDLER(MOVREG_R1_DATABUS):
+					_movReg(m_R1, &m_dataBusValue);
+					NEXT;
+
+				HANDLER(MOVREG_R1_R1):
+					_movReg(m_R1, m_R1);
+					NEXT;
+
+				HANDLER(MOVREG_R1_R2):
+					_movReg(m_R1, m_R2);
+					NEXT;
+
+				HANDLER(MOVREG_R1_R4):
+					_movReg(m_R1, m_R4);
+					NEXT;
+
+				HANDLER(MOVREG_R1_V1):
+					_movReg(m_R1, &m_V1);
+					NEXT;
+
+				HANDLER(MOVREG_R2_ALUOUT):
+					_movReg(m_R2, &m_aluOut);
+					NEXT;
+
+				HANDLER(MOVREG_R2_DATABUS):
+					_movReg(m_R2, &m_dataBusValue);
+					NEXT;
+
+				HANDLER(MOVREG_R2_R1):
+					_movReg(m_R2, m_R1);
+					NEXT;
+
+				HANDLER(MOVREG_R2_R2):
+					_movReg(m_R2, m_R2);
+					NEXT;
+
+				HANDLER(MOVREG_R2_R4):
+					_movReg(m_R2, m_R4);
+					NEXT;
+
+				HANDLER(MOVREG_R2_V1):
+					_movReg(m_R2, &m_V1);
+					NEXT;
+
+				HANDLER(MOVREG_R4_ALUOUT):
+					_movReg(m_R4, &m_aluOut);
+					NEXT;
+
+				HANDLER(MOVREG_R4_DATABUS):
+					_movReg(m_R4, &m_dataBusValue);
+					NEXT;
+
+				HANDLER(MOVREG_R4_R1):
+					_movReg(m_R4, m_R1);
+					NEXT;
+
+				HANDLER(MOVREG_R4_R2):
+					_movReg(m_R4, m_R2);
+					NEXT;
+
+				HANDLER(MOVREG_R4_R4):
+					_movReg(m_R4, m_R4);
+					NEXT;
+
+				HANDLER(MOVREG_R4_V1):
+					_movReg(m_R4, &m_V1);
+					NEXT;
+
+				HANDLER(MOVREG_I_ALUOUT):
+					_movReg(&m_registers[(int)Registers::I], &m_aluOut);
+					NEXT;
+
+				HANDLER(MOVREG_I_DATABUS):
+					_movReg(&m_registers[(int)Registers::I], &m_dataBusValue);
+					NEXT;
+
+				HANDLER(MOVREG_I_R1):
+					_movReg(&m_registers[(int)Registers::I], m_R1);
+					NEXT;
+
+				HANDLER(MOVREG_I_R2):
+					_movReg(&m_registers[(int)Registers::I], m_R2);
+					NEXT;
+
+				HANDLER(MOVREG_I_R4):
+					_movReg(&m_registers[(int)Registers::I], m_R4);
+					NEXT;
+
+				HANDLER(MOVREG_I_V1):
+					_movReg(&m_registers[(int)Registers::I], &m_V1);
+					NEXT;
+
+				HANDLER(MOVDATABUS_ALUOUT):
+					_movDataBus(m_aluOut);
+					NEXT;
+
+				HANDLER(MOVDATABUS_R1):
+					_movDataBus(*m_R1);
+					NEXT;
+
+				HANDLER(MOVDATABUS_R2):
+					_movDataBus(*m_R2);
+					NEXT;
+
+				HANDLER(MOVDATABUS_R4):
+					_movDataBus(*m_R4);
+					NEXT;
+
+				HANDLER(MOVDATABUS_V1):
+					_movDataBus(m_V1);
+					NEXT;
+
+				HANDLER(MOVDATABUS_PC_16):
+					_movDataBus((uint8_t)((m_programCounter & 0xFF0000) >> 16));
+					NEXT;
+
+				HANDLER(MOVDATABUS_PC_8):
+					_movDataBus((uint8_t)((m_programCounter & 0x00FF00) >> 8));
+					NEXT;
+
+				HANDLER(MOVDATABUS_PC8):
+					_movDataBus((uint8_t)(m_programCounter & 0x0000FF));
+					NEXT;
+
+				HANDLER(MOVADDBUS_V1):
+					_movAddBus(m_V1);
+					NEXT;
+
+				HANDLER(MOVADDBUS_R1):
+					_movAddBus(*m_R1);
+					NEXT;
+
+				HANDLER(MOVADDBUS_R2):
+					_movAddBus(*m_R2);
+					NEXT;
+
+				HANDLER(MOVADDBUS_RX):
+					_movAddBus(m_Rx);
+					NEXT;
+
+				HANDLER(MOVADDBUS_VX):
+					_movAddBus(m_Vx);
+					NEXT;
+
+				HANDLER(MOVADDBUS_STK):
+					_movAddBus(m_stackPointer);
+					NEXT;
+
+				HANDLER(MOVPC_RX):
+					_movPC(m_Rx);
+					NEXT;
 
-				m_codeStep++;
+				HANDLER(MOVPC_VX):
+					_movPC(m_Vx);
+					NEXT;
+
+				HANDLER(MOVPC_DATABUS16):
+					_movPC(m_mb->getDataBus() << 16);
+					NEXT;
+
+				HANDLER(MOVPC_PCDATABUS8):
+					_movPC((m_mb->getDataBus() << 8) + m_programCounter);
+					NEXT;
+
+				HANDLER(MOVPC_PCDATABUS):
+					_movPC(m_mb->getDataBus() + m_programCounter);
+					NEXT;
+
+				HANDLER(JMC_RX):
+					_jmc(m_Rx);
+					NEXT;
+
+				HANDLER(JMC_VX):
+					_jmc(m_Vx);
+					NEXT;
+
+				HANDLER(JME_RX):
+					_jme(m_Rx);
+					NEXT;
+
+				HANDLER(JME_VX):
+					_jme(m_Vx);
+					NEXT;
+
+				HANDLER(JMF_RX):
+					_jmf(m_Rx);
+					NEXT;
+
+				HANDLER(JMF_VX):
+					_jmf(m_Vx);
+					NEXT;
+
+				HANDLER(JMK_RX):
+					_jmk(m_Rx);
+					NEXT;
+
+				HANDLER(JMK_VX):
+					_jmk(m_Vx);
+					NEXT;
+
+				HANDLER(JMP_RX):
+					_jmp(m_Rx);
+					NEXT;
+
+				HANDLER(JMP_VX):
+					_jmp(m_Vx);
+					NEXT;
+
+				HANDLER(JMS_RX):
+					_jms(m_Rx);
+					NEXT;
+
+				HANDLER(JMS_VX):
+					_jms(m_Vx);
+					NEXT;
+
+				HANDLER(JMZ_RX):
+					_jmz(m_Rx);
+					NEXT;
+
+				HANDLER(JMZ_VX):
+					_jmz(m_Vx);
+					NEXT;
+
+				HANDLER(JMN_RX):
+					_jmn(m_Rx);
+					NEXT;
+
+				HANDLER(JMN_VX):
+					_jmn(m_Vx);
+					NEXT;
+				}
 			}
 			break;
 		}
@@ -738,6 +727,31 @@ Step CPU::getCurrentStep()
 	return m_step;
 }
 
+bool CPU::isAtInstructionBoundary()
+{
+	return m_step == Step::FETCH_1;
+}
+
+bool CPU::isHalted()
+{
+	return (m_flags & FLAG_HALT) != 0;
+}
+
+uint64_t CPU::getInstructionsCount()
+{
+	return m_instructionsCount;
+}
+
+DecodeCache* CPU::getDecodeCache()
+{
+	return m_decodeCache;
+}
+
+BlockCache* CPU::getBlockCache()
+{
+	return m_blockCache;
+}
+
 std::string CPU::getCurrentCode()
 {
 	std::string instruction("");
@@ -1199,18 +1213,27 @@ uint32_t CPU::getProgramCounter()
 
 std::string CPU::getFlagsRegister()
 {
-	std::string carry(m_flags.CARRY ? "1  " : "0  ");
-	std::string zero(m_flags.ZERO ? "1  " : "0  ");
-	std::string halt(m_flags.HALT ? "1  " : "0  ");
-	std::string negative(m_flags.NEGATIVE ? "1  " : "0  ");
-	std::string inferior(m_flags.INFERIOR ? "1  " : "0  ");
-	std::string superior(m_flags.SUPERIOR ? "1  " : "0  ");
-	std::string equal(m_flags.EQUAL ? "1  " : "0  ");
-	std::string interrupt(m_flags.INTERRUPT ? "1" : "0");
+	evaluateFlags();
+
+	std::string carry((m_flags & FLAG_CARRY) ? "1  " : "0  ");
+	std::string zero((m_flags & FLAG_ZERO) ? "1  " : "0  ");
+	std::string halt((m_flags & FLAG_HALT) ? "1  " : "0  ");
+	std::string negative((m_flags & FLAG_NEGATIVE) ? "1  " : "0  ");
+	std::string inferior((m_flags & FLAG_INFERIOR) ? "1  " : "0  ");
+	std::string superior((m_flags & FLAG_SUPERIOR) ? "1  " : "0  ");
+	std::string equal((m_flags & FLAG_EQUAL) ? "1  " : "0  ");
+	std::string interrupt((m_flags & FLAG_INTERRUPT) ? "1" : "0");
 
 	return carry + zero + halt + negative + inferior + superior + equal + interrupt;
 }
 
+uint8_t CPU::getFlags()
+{
+	evaluateFlags();
+
+	return m_flags;
+}
+
 uint8_t CPU::getAcc1()
 {
 	return m_accu1;
@@ -1317,1218 +1340,22 @@ uint8_t CPU::getRegY()
 
 
 // PRIVATE
-void CPU::initcode()
-{
-	uInstruction temp;
-
-	// === ADC ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::ADC;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg/Imm8 --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::ADC;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// -- Reg/Ram --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::ADC;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::ADC].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	// === ADD ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::ADD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg/Imm8 --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::ADD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// -- Reg/Ram --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::ADD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::ADD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	// === AND ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::AND;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg/Imm8 --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::AND;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// -- Reg/Ram --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::AND;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::AND].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	// === CAL ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::PC8 };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::INCSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::PC_8 };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::INCSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::PC_16 };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::INCSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::PC8 };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::INCSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::PC_8 };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::INCSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::PC_16 };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::INCSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::CAL].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === CLC ===
-	// -- None --
-	temp.uopcode = opcodesList::CLC;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CLC].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === CLE ===
-	// -- None --
-	temp.uopcode = opcodesList::CLE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CLE].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === CLI ===
-	// -- None --
-	temp.uopcode = opcodesList::CLI;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CLI].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === CLN ===
-	// -- None --
-	temp.uopcode = opcodesList::CLN;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CLN].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === CLS ===
-	// -- None --
-	temp.uopcode = opcodesList::CLS;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CLS].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === CLZ ===
-	// -- None --
-	temp.uopcode = opcodesList::CLZ;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CLZ].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === CLF ===
-	// -- None --
-	temp.uopcode = opcodesList::CLF;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CLF].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === CMP ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::CMP;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg/Imm8 --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::CMP;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// -- Reg/Ram --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R4 };
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::CMP;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::CMP].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-	
-	// === DEC ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::X1 };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::SUB;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-	
-	// -- Reg24 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::X1 };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::SUB;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::X1 };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::SUB;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::DEC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === HLT ===
-	// -- None --
-	temp.uopcode = opcodesList::STH;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::HLT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === IN ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::IN].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::IN;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IN].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::IN].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// === OUT ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::OUT].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::OUT].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::OUT;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::OUT].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// === INC ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::X1 };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::ADD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg24 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::X1 };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::ADD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-	
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::X1 };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::ADD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === INT ===
-	// -- Imm8 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::INT].addrMode[(int)AddressingModesList::IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::INT;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::INT].addrMode[(int)AddressingModesList::IMM8].push_back(temp);
-
-	// === IRT ===
-	// -- None --
-	temp.uopcode = opcodesList::STI;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK };
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::I, operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::DATABUS16 };
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::PCDATABUS8 };
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::PCDATABUS };
-	m_instructionsUCode[(int)InstructionsList::IRT].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === JMC ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JMC;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JMC].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JMC;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JMC].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === JME ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JME;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JME].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JME;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JME].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === JMF ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JMF;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JMF].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JMF;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JMF].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === JMK ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JMK;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JMK].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JMK;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JMK].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === JMP ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JMP;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JMP].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JMP;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JMP].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === JMS ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JMS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JMS].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JMS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JMS].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === JMZ ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JMZ;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JMZ].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JMZ;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JMZ].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === JMN ===
-	// -- Reg24 --
-	temp.uopcode = opcodesList::JMN;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::JMN].addrMode[(int)AddressingModesList::REG24].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::JMN;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::JMN].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === STR ===
-	// -- RamReg / ImmReg --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::STR].addrMode[(int)AddressingModesList::RAMREG_IMMREG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::R4 };
-	m_instructionsUCode[(int)InstructionsList::STR].addrMode[(int)AddressingModesList::RAMREG_IMMREG].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STR].addrMode[(int)AddressingModesList::RAMREG_IMMREG].push_back(temp);
-
-	// -- Reg / Ram --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::STR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::STR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	// === LOD ===
-	// -- RamReg / ImmReg --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::RX };
-	m_instructionsUCode[(int)InstructionsList::LOD].addrMode[(int)AddressingModesList::RAMREG_IMMREG].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::LOD].addrMode[(int)AddressingModesList::RAMREG_IMMREG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R4, operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::LOD].addrMode[(int)AddressingModesList::RAMREG_IMMREG].push_back(temp);
-
-	// -- Reg / Ram --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::LOD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::LOD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::LOD].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	// === MOV ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::MOV].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg / Imm8 --
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::MOV].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// === NOT ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::NOT;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Imm24 --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::NOT;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::NOT].addrMode[(int)AddressingModesList::IMM24].push_back(temp);
-
-	// === OR ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::OR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg / Imm8 --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::OR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// -- Reg / Ram --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::OR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::OR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	// === POP ===
-	// -- Reg --
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::POP].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::POP].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::POP].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::POP].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// === PSH ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::PSH].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVDATABUS;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::PSH].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMWRITE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::PSH].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::INCSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::PSH].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// === RET ===
-	// -- None --
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::DATABUS16 };
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::PCDATABUS8 };
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::DECSTK;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::STK};
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVPC;
-	temp.uoperands = { operandsList::PCDATABUS };
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	temp.uopcode = opcodesList::INCPC;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::RET].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === SHL ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::SHL].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::SHL;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::SHL].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::SHL].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// === ASR ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::ASR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::ASR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::ASR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::ASR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// === SHR ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::SHR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::SHR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::SHR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::SHR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// === STC ===
-	// -- None --
-	temp.uopcode = opcodesList::STC;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STC].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === STI ===
-	// -- None --
-	temp.uopcode = opcodesList::STI;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STI].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === STN ===
-	// -- None --
-	temp.uopcode = opcodesList::STN;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STN].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === STF ===
-	// -- None --
-	temp.uopcode = opcodesList::STF;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STF].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === STS ===
-	// -- None --
-	temp.uopcode = opcodesList::STS;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STS].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === STE ===
-	// -- None --
-	temp.uopcode = opcodesList::STE;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STE].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-
-	// === STZ ===
-	// -- None --
-	temp.uopcode = opcodesList::STZ;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::STZ].addrMode[(int)AddressingModesList::NONE].push_back(temp);
-	
-	// === SUB ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::SUB;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg/Imm8 --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::SUB;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// -- Reg/Ram --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::SUB;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::SUB].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	// === XOR ===
-	// -- Reg --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-	
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::R2 };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::XOR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG].push_back(temp);
-
-	// -- Reg/Imm8 --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::V1 };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::XOR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_IMM8].push_back(temp);
-
-	// -- Reg/Ram --
-	temp.uopcode = opcodesList::MOVACC1;
-	temp.uoperands = { operandsList::R1 };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVADDBUS;
-	temp.uoperands = { operandsList::VX };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::RAMREAD;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVACC2;
-	temp.uoperands = { operandsList::DATABUS };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::XOR;
-	temp.uoperands.clear();
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
-
-	temp.uopcode = opcodesList::MOVREG;
-	temp.uoperands = { operandsList::R1, operandsList::ALUOUT };
-	m_instructionsUCode[(int)InstructionsList::XOR].addrMode[(int)AddressingModesList::REG_RAM].push_back(temp);
+void CPU::decode()
+{
+	m_opcode = (uint8_t)((m_fetchedInstruction & 0xFC00000000) >> 34);
+	m_addressingMode = (uint8_t)((m_fetchedInstruction & 0x03C0000000) >> 30);
+	m_R1 = &m_registers[(m_fetchedInstruction & 0x0038000000) >> 27];
+	m_R2 = &m_registers[(m_fetchedInstruction & 0x0007000000) >> 24];
+	m_V1 = (uint8_t)((m_fetchedInstruction & 0x0000FF0000) >> 16);
+	m_V2 = (m_fetchedInstruction & 0x000000FF00) >> 8;
+	m_Ex = m_fetchedInstruction & 0x00000000FF;
+	m_Vx = ((uint32_t)(m_V1) << 16) + ((uint32_t)(m_V2) << 8) + (uint32_t)(m_Ex);
+	m_R3 = &m_registers[m_V1 & 0x07];
+	m_R4 = &m_registers[m_Ex & 0x07];
+	m_Rx = ((uint32_t)(*m_R1) << 16) + ((uint32_t)(*m_R2) << 8) + (uint32_t)(*m_R3);
+
+	m_codeStart = codeROM.index[m_opcode][m_addressingMode].start;
+	m_codeLength = codeROM.index[m_opcode][m_addressingMode].length;
 }
 
 // pocodes
@@ -2595,82 +1422,96 @@ void CPU::_incPC()
 
 void CPU::_clc()
 {
-	m_flags.CARRY = false;
+	evaluateFlags(); // Otherwise the pending flags would overwrite this one later
+	m_flags &= ~FLAG_CARRY;
 }
 
 void CPU::_cle()
 {
-	m_flags.EQUAL = false;
+	evaluateFlags();
+	m_flags &= ~FLAG_EQUAL;
 }
 
 void CPU::_cli()
 {
-	m_flags.INTERRUPT = false;
+	m_flags &= ~FLAG_INTERRUPT;
 }
 
 void CPU::_cln()
 {
-	m_flags.NEGATIVE = false;
+	evaluateFlags();
+	m_flags &= ~FLAG_NEGATIVE;
 }
 
 void CPU::_cls()
 {
-	m_flags.SUPERIOR = false;
+	evaluateFlags();
+	m_flags &= ~FLAG_SUPERIOR;
 }
 
 void CPU::_clz()
 {
-	m_flags.ZERO = false;
+	evaluateFlags();
+	m_flags &= ~FLAG_ZERO;
 }
 
 void CPU::_clf()
 {
-	m_flags.INFERIOR = false;
+	evaluateFlags();
+	m_flags &= ~FLAG_INFERIOR;
 }
 
 void CPU::_sth()
 {
-	m_flags.HALT = true;
+	m_flags |= FLAG_HALT;
 }
 
 void CPU::_stc()
 {
-	m_flags.CARRY = true;
+	evaluateFlags();
+	m_flags |= FLAG_CARRY;
 }
 
 void CPU::_sti()
 {
-	m_flags.INTERRUPT = true;
+	m_flags |= FLAG_INTERRUPT;
 }
 
 void CPU::_stn()
 {
-	m_flags.NEGATIVE = true;
+	evaluateFlags();
+	m_flags |= FLAG_NEGATIVE;
 }
 
 void CPU::_stf()
 {
-	m_flags.INFERIOR = true;
+	evaluateFlags();
+	m_flags |= FLAG_INFERIOR;
 }
 
 void CPU::_sts()
 {
-	m_flags.SUPERIOR = true;
+	evaluateFlags();
+	m_flags |= FLAG_SUPERIOR;
 }
 
 void CPU::_ste()
 {
-	m_flags.EQUAL = true;
+	evaluateFlags();
+	m_flags |= FLAG_EQUAL;
 }
 
 void CPU::_stz()
 {
-	m_flags.ZERO = true;
+	evaluateFlags();
+	m_flags |= FLAG_ZERO;
 }
 
 void CPU::_jmc(uint32_t addr)
 {
-	if (m_flags.CARRY)
+	evaluateFlags();
+
+	if (m_flags & FLAG_CARRY)
 	{
 		m_programCounter = addr & 0x00FFFFFF;
 		m_jump = true;
@@ -2679,7 +1520,9 @@ void CPU::_jmc(uint32_t addr)
 
 void CPU::_jme(uint32_t addr)
 {
-	if (m_flags.EQUAL)
+	evaluateFlags();
+
+	if (m_flags & FLAG_EQUAL)
 	{
 		m_programCounter = addr & 0x00FFFFFF;
 		m_jump = true;
@@ -2688,7 +1531,9 @@ void CPU::_jme(uint32_t addr)
 
 void CPU::_jmf(uint32_t addr)
 {
-	if (m_flags.INFERIOR)
+	evaluateFlags();
+
+	if (m_flags & FLAG_INFERIOR)
 	{
 		m_programCounter = addr & 0x00FFFFFF;
 		m_jump = true;
@@ -2716,7 +1561,9 @@ void CPU::_jmp(uint32_t addr)
 
 void CPU::_jms(uint32_t addr)
 {
-	if (m_flags.SUPERIOR)
+	evaluateFlags();
+
+	if (m_flags & FLAG_SUPERIOR)
 	{
 		m_programCounter = addr & 0x00FFFFFF;
 		m_jump = true;
@@ -2725,7 +1572,9 @@ void CPU::_jms(uint32_t addr)
 
 void CPU::_jmz(uint32_t addr)
 {
-	if (m_flags.ZERO)
+	evaluateFlags();
+
+	if (m_flags & FLAG_ZERO)
 	{
 		m_programCounter = addr & 0x00FFFFFF;
 		m_jump = true;
@@ -2734,7 +1583,9 @@ void CPU::_jmz(uint32_t addr)
 
 void CPU::_jmn(uint32_t addr)
 {
-	if (m_flags.NEGATIVE)
+	evaluateFlags();
+
+	if (m_flags & FLAG_NEGATIVE)
 	{
 		m_programCounter = addr & 0x00FFFFFF;
 		m_jump = true;
@@ -2758,73 +1609,61 @@ void CPU::_interrupt()
 	m_softwareInterrupt = true;
 }
 
-// ALU OPERATIONS
+// ALU OPERATIONS : the flags are only recorded, evaluateFlags() computes them when they are read
 void CPU::_adc()
 {
 	m_aluOut = m_accu1 + m_accu2 + 1;
 
-	m_flags.CARRY = (((int)m_accu1 + (int)m_accu2 + 1) > 0xFF) ? true : false;
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::ADC);
 }
 
 void CPU::_add()
 {
 	m_aluOut = m_accu1 + m_accu2;
 
-	m_flags.CARRY = (((int)m_accu1 + (int)m_accu2) > 0xFF) ? true : false;
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::ADD);
 }
 
 void CPU::_sub()
 {
 	m_aluOut = m_accu1 - m_accu2;
 
-	m_flags.CARRY = (((int)m_accu1 + (int)m_accu2) > 0xFF) ? true : false;
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::ADD); // The carry is the one of the addition
 }
 
 void CPU::_and()
 {
 	m_aluOut = m_accu1 & m_accu2;
 
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::LOGIC);
 }
 
 void CPU::_or()
 {
 	m_aluOut = m_accu1 | m_accu2;
 
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::LOGIC);
 }
 
 void CPU::_xor()
 {
 	m_aluOut = m_accu1 ^ m_accu2;
 
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::LOGIC);
 }
 
 void CPU::_not()
 {
 	m_aluOut = ~m_accu1;
 
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::LOGIC);
 }
 
 void CPU::_shl()
 {
 	m_aluOut = m_accu1 << 1;
 
-	m_flags.CARRY = (((int)m_accu1 << 1) > 0xFF) ? true : false;
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true; // Sign bit
+	deferFlags(FlagsUpdate::SHIFT);
 }
 
 void CPU::_asr()
@@ -2836,24 +1675,70 @@ void CPU::_asr()
 		m_aluOut |= (0x01 << 7); // This code differentiates arithmetical shift from logical shift
 	}
 
-	m_flags.CARRY = (((int)m_accu1 << 1) > 0xFF) ? true : false;
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true;
+	deferFlags(FlagsUpdate::SHIFT);
 }
 
 void CPU::_shr()
 {
 	m_aluOut = m_accu1 >> 1;
 
-	m_flags.CARRY = (((int)m_accu1 << 1) > 0xFF) ? true : false;
-	m_flags.ZERO = (m_aluOut == 0x00) ? true : false;
-	m_flags.NEGATIVE = ((m_aluOut & 0x80) == 0x00) ? false : true;
+	deferFlags(FlagsUpdate::SHIFT);
 }
 
 void CPU::_cmp()
 {
-	m_flags.ZERO = (m_accu1 == 0x00) ? true : false;
-	m_flags.EQUAL = (m_accu1 == m_accu2) ? true : false;
-	m_flags.INFERIOR = (m_accu1 < m_accu2) ? true : false;
-	m_flags.SUPERIOR = (m_accu1 > m_accu2) ? true : false;
+	deferFlags(FlagsUpdate::CMP);
+}
+
+void CPU::deferFlags(FlagsUpdate update)
+{
+	FlagsUpdate pending(m_pendingFlags.update);
+	bool setsCarry(update == FlagsUpdate::ADC || update == FlagsUpdate::ADD || update == FlagsUpdate::SHIFT);
+
+	if (pending != FlagsUpdate::NONE && pending != update && !(setsCarry && pending != FlagsUpdate::CMP)) // The pending flags aren't all overwritten by this update
+		evaluateFlags();
+
+	m_pendingFlags = {update, m_accu1, m_accu2, m_aluOut};
+}
+
+void CPU::evaluateFlags()
+{
+	const uint8_t operand1(m_pendingFlags.operand1), operand2(m_pendingFlags.operand2), result(m_pendingFlags.result);
+	uint8_t mask(FLAG_ZERO | FLAG_NEGATIVE), flags(0);
+
+	switch (m_pendingFlags.update)
+	{
+	case FlagsUpdate::NONE:
+		return;
+
+	case FlagsUpdate::ADC:
+		mask |= FLAG_CARRY;
+		flags |= (((int)operand1 + (int)operand2 + 1) > 0xFF) ? FLAG_CARRY : 0;
+		break;
+
+	case FlagsUpdate::ADD:
+		mask |= FLAG_CARRY;
+		flags |= (((int)operand1 + (int)operand2) > 0xFF) ? FLAG_CARRY : 0;
+		break;
+
+	case FlagsUpdate::LOGIC:
+		break;
+
+	case FlagsUpdate::SHIFT:
+		mask |= FLAG_CARRY;
+		flags |= (((int)operand1 << 1) > 0xFF) ? FLAG_CARRY : 0; // Sign bit of the operand, whatever the shift direction
+		break;
+
+	case FlagsUpdate::CMP: // The negative flag is left as is
+		m_flags = (m_flags & ~(FLAG_ZERO | FLAG_EQUAL | FLAG_INFERIOR | FLAG_SUPERIOR)) | ((operand1 == 0x00) ? FLAG_ZERO : 0) | ((operand1 == operand2) ? FLAG_EQUAL : 0)
+			| ((operand1 < operand2) ? FLAG_INFERIOR : 0) | ((operand1 > operand2) ? FLAG_SUPERIOR : 0);
+		m_pendingFlags.update = FlagsUpdate::NONE;
+		return;
+	}
+
+	flags |= (result == 0x00) ? FLAG_ZERO : 0;
+	flags |= result & FLAG_NEGATIVE; // Sign bit
+
+	m_flags = (m_flags & ~mask) | flags;
+	m_pendingFlags.update = FlagsUpdate::NONE;
 }
@@ -2,63 +2,62 @@
 
 #include "defines.hpp"
 #include "motherboard.hpp"
+#include "microcode.hpp"
+#include "decodecache.hpp"
+#include "blockcache.hpp"
+#include "jit.hpp"
 
-enum class Step {FETCH_1, FETCH_2, FETCH_3, FETCH_4, FETCH_5, DECODE, EXECUTE, STOP, INTERRUPT_1, INTERRUPT_2, INTERRUPT_3, INTERRUPT_4, INTERRUPT_5, INTERRUPT_6, INTERRUPT_7, INTERRUPT_8};
-
-#define INSTRUCTIONS_NB 48 // Including NOP (0x0 by definition)
-#define ADDRESSING_MODES_NB 8
-
-enum class InstructionsList {NOP = 0x0,  ADC = 0x1,  ADD = 0x2,  AND = 0x3,  CAL = 0x4,  CLC = 0x5,  CLE = 0x6,  CLI = 0x7,  CLN = 0x8,  CLS = 0x9,  CLZ = 0xA,  CLF = 0xB,
-							 CMP = 0xC,  DEC = 0xD,  HLT = 0xE,  IN = 0xF,   OUT = 0x10, INC = 0x11, INT = 0x12, IRT = 0x13, JMC = 0x14, JME = 0x15, JMF = 0x16, JMK = 0x17,
-							 JMP = 0x18, JMS = 0x19, JMZ = 0x1A, JMN = 0x1B, STR = 0x1C, LOD = 0x1D, MOV = 0x1E, NOT = 0x1F, OR = 0x20,  POP = 0x21, PSH = 0x22, RET = 0x23,
-							 SHL = 0x24, ASR = 0x25, SHR = 0x26, STC = 0x27, STI = 0x28, STN = 0x29, STF = 0x2A, STS = 0x2B, STE = 0x2C, STZ = 0x2D, SUB = 0x2E, XOR = 0x2F};
-
-enum class AddressingModesList {NONE = 0x0, REG = 0x1, REG_IMM8 = 0x2, REG_RAM = 0x3, RAMREG_IMMREG = 0x4, REG24 = 0x5, IMM24 = 0x6, IMM8 = 0x7};
+enum class Engine {MICROCODE, INTERPRETER, BLOCKS, JIT}; // Cycle accurate code engine, whole instructions at once, whole translated blocks at once, or compiled blocks
 
-enum class opcodesList {MOVACC1, MOVACC2, MOVPC, MOVADDBUS, MOVDATABUS, MOVREG, RAMREAD, RAMWRITE, DECSTK, INCSTK, CLC, CLE, CLI, CLN, CLS, CLZ, CLF, STH, STC, STI,
-						 STN, STF, STS, STE, STZ, JMC, JME, JMF, JMK, JMP, JMS, JMZ, JMN, IN, OUT, INT, ADC, ADD, SUB, AND, OR, XOR, NOT, SHL, ASR, SHR, CMP, INCPC, UNDEFINED};
-
-enum class operandsList {R1, R2, R4, V1, VX, RX, ALUOUT, DATABUS, DATABUS16, PCDATABUS8, PCDATABUS, STK, X1, PC_16, PC_8, PC8, I};
-
-typedef struct
-{
-	opcodesList uopcode;
-	std::vector<operandsList> uoperands;
-} uInstruction;
+#define INSTRUCTION_OVERHEAD_CYCLES 7 // Fetch (5 cycles), decode and end of instruction around the code, in the code engine
 
-typedef struct
-{
-	std::vector<uInstruction> addrMode[ADDRESSING_MODES_NB];
-} Instruction;
+enum class Step {FETCH_1, FETCH_2, FETCH_3, FETCH_4, FETCH_5, DECODE, EXECUTE, STOP, INTERRUPT_1, INTERRUPT_2, INTERRUPT_3, INTERRUPT_4, INTERRUPT_5, INTERRUPT_6, INTERRUPT_7, INTERRUPT_8};
 
 #define REGISTER_NB 8
 enum class Registers {A = 0x0, B = 0x1, C = 0x2, D = 0x3, I = 0x4, J = 0x5, X = 0x6, Y = 0x7};
 
-typedef struct
+// Flags register bits, carry, zero and negative are where the x86 flags register has them so the JIT can store them directly
+#define FLAG_CARRY 0x01
+#define FLAG_HALT 0x02
+#define FLAG_INFERIOR 0x04
+#define FLAG_SUPERIOR 0x08
+#define FLAG_EQUAL 0x10
+#define FLAG_INTERRUPT 0x20
+#define FLAG_ZERO 0x40
+#define FLAG_NEGATIVE 0x80
+
+enum class FlagsUpdate : uint8_t {NONE, ADC, ADD, LOGIC, SHIFT, CMP}; // How the last ALU operation sets the flags, SUB sets them as ADD
+
+typedef struct // Last ALU operation, whose flags are only computed once read
 {
-	bool CARRY;
-	bool ZERO;
-	bool HALT;
-	bool NEGATIVE;
-	bool INFERIOR;
-	bool SUPERIOR;
-	bool EQUAL;
-	bool INTERRUPT;
-} Flags;
+	FlagsUpdate update; // NONE once the flags register is up to date
+	uint8_t operand1;
+	uint8_t operand2;
+	uint8_t result;
+} PendingFlags;
 
 class CPU
 {
 	public:
 		CPU(Motherboard* mb);
+		~CPU();
 
 		void tick();
+		unsigned int step(); // Runs a whole instruction, returns the number of cycles the code engine would have spent on it
+		unsigned int runBlocks(unsigned int maxCycles, bool jit); // Runs chained blocks up to the first instruction boundary after maxCycles cycles, returns the number of cycles spent
 
 		// Getters
 		Step getCurrentStep();
+		bool isAtInstructionBoundary();
+		bool isHalted();
+		uint64_t getInstructionsCount();
+		DecodeCache* getDecodeCache(); // nullptr until the interpreter runs
+		BlockCache* getBlockCache(); // nullptr until the blocks engine runs
 		std::string getCurrentCode();
 		uint8_t getStackPointer();
 		uint32_t getProgramCounter();
 		std::string getFlagsRegister();
+		uint8_t getFlags(); // FLAG_ bits
 		uint8_t getAcc1();
 		uint8_t getAcc2();
 		std::string getop();
@@ -73,7 +72,20 @@ class CPU
 		uint8_t getRegY();
 
 	private:
-		void initcode();
+		void decode();
+		void saveDecoded(DecodedInstruction* decoded);
+		void loadDecoded(const DecodedInstruction* decoded);
+
+		// Instruction-level engine
+		void execute();
+		Block* translateBlock(uint32_t address);
+		void compileBlock(Block* block);
+		unsigned int enterInterrupt();
+		uint8_t readRAM(uint32_t address);
+		void writeRAM(uint8_t data, uint32_t address);
+		void push(uint8_t data);
+		uint8_t pop();
+
 		// opcodes
 		void _movAcc1(uint8_t v);
 		void _movAcc2(uint8_t v);
@@ -123,8 +135,8 @@ class CPU
 		void _asr();
 		void _shr();
 		void _cmp();
-
-		Instruction m_instructionsUCode[INSTRUCTIONS_NB];
+		void deferFlags(FlagsUpdate update);
+		void evaluateFlags();
 
 		Motherboard* m_mb;
 
@@ -135,6 +147,8 @@ class CPU
 		uint64_t m_fetchedInstruction;
 		uint8_t m_opcode; // 6 last bits
 		uint8_t m_addressingMode; // 4 last bits
+		uint16_t m_codeStart; // Decoded instruction location in the code ROM
+		uint16_t m_codeLength;
 		uint8_t* m_R1; // 3 last bits
 		uint8_t* m_R2; // 3 last bits
 		uint8_t* m_R3; // 3 last bits
@@ -147,10 +161,13 @@ class CPU
 		uint32_t m_interruptVector;
 		uint8_t m_interruptPort;
 		uint8_t m_dataBusValue;
-		uint8_t* m_pointedRegister;
-		uint8_t* m_valueToStore;
 		opcodesList m_code;
 		
+		uint64_t m_instructionsCount;
+		DecodeCache* m_decodeCache; // Only used by the interpreter
+		BlockCache* m_blockCache; // Only used by the blocks engine
+		JitBuffer* m_jitBuffer; // Only used by the JIT engine
+
 		bool m_jump;
 		bool m_softwareInterrupt;
 		uint8_t m_accu1;
@@ -158,7 +175,8 @@ class CPU
 		uint8_t m_aluOut;
 		uint8_t m_registers[REGISTER_NB];
 		uint8_t m_interruptData;
-		Flags m_flags;
+		uint8_t m_flags; // FLAG_ bits, except the ones still pending
+		PendingFlags m_pendingFlags;
 		uint32_t m_programCounter;
 		uint32_t m_stackPointer;
 };
@@ -0,0 +1,84 @@
+#include "decodecache.hpp"
+
+DecodeCache::DecodeCache(RAM* ram)
+{
+	m_ram = ram;
+
+	m_hits = 0;
+	m_misses = 0;
+	m_invalidations = 0;
+
+	flush();
+
+	m_ram->addWriteListener(this);
+}
+
+DecodeCache::~DecodeCache()
+{
+	m_ram->removeWriteListener(this);
+}
+
+DecodedInstruction* DecodeCache::lookup(uint32_t address)
+{
+	DecodedInstruction* entry(&m_entries[address & (DECODE_CACHE_SIZE - 1)]);
+
+	if (entry->address == address)
+	{
+		m_hits++;
+		return entry;
+	}
+
+	m_misses++;
+	return nullptr;
+}
+
+DecodedInstruction* DecodeCache::allocate(uint32_t address)
+{
+	DecodedInstruction* entry(&m_entries[address & (DECODE_CACHE_SIZE - 1)]);
+
+	entry->address = address; // Replaces any instruction previously cached in this entry
+
+	m_ram->watchPage(address);
+	m_ram->watchPage(address + 4); // The instruction may overlap two pages
+
+	return entry;
+}
+
+void DecodeCache::flush()
+{
+	for (unsigned int i(0); i < DECODE_CACHE_SIZE; i++)
+	{
+		m_entries[i].address = DECODE_CACHE_EMPTY_TAG;
+	}
+}
+
+void DecodeCache::onMemoryWrite(uint32_t address)
+{
+	for (uint32_t offset(0); offset < 5; offset++) // Instructions starting up to 4 bytes before hold the written byte
+	{
+		uint32_t start((address - offset) & 0x00FFFFFF); // The instructions at the end of the address space wrap around to its beginning
+		DecodedInstruction* entry(&m_entries[start & (DECODE_CACHE_SIZE - 1)]);
+
+		if (entry->address == start)
+		{
+			entry->address = DECODE_CACHE_EMPTY_TAG;
+			m_invalidations++;
+		}
+	}
+}
+
+// GETTERS
+uint64_t DecodeCache::getHits()
+{
+	return m_hits;
+}
+
+uint64_t DecodeCache::getMisses()
+{
+	return m_misses;
+}
+
+uint64_t DecodeCache::getInvalidations()
+{
+	return m_invalidations;
+}
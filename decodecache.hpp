@@ -0,0 +1,53 @@
+#pragma once
+
+#include "defines.hpp"
+#include "ram.hpp"
+
+#define DECODE_CACHE_SIZE 4096 // Entries, must be a power of two
+#define DECODE_CACHE_EMPTY_TAG 0xFFFFFFFF // Never a valid 24-bit address
+
+typedef struct
+{
+	uint32_t address; // Tag, address of the first byte of the instruction
+	uint64_t instruction;
+	uint8_t opcode;
+	uint8_t addressingMode;
+	uint8_t R1; // Register indexes
+	uint8_t R2;
+	uint8_t R3;
+	uint8_t R4;
+	uint8_t V1;
+	uint8_t V2;
+	uint8_t Ex;
+	uint32_t Vx;
+	uint16_t codeStart;
+	uint16_t codeLength;
+} DecodedInstruction;
+
+// Direct-mapped cache of decoded instructions, keyed by address and invalidated by the RAM writes over the cached bytes
+class DecodeCache : public MemoryWriteListener
+{
+	public:
+		DecodeCache(RAM* ram);
+		~DecodeCache();
+
+		DecodedInstruction* lookup(uint32_t address); // nullptr if the instruction at this address isn't cached
+		DecodedInstruction* allocate(uint32_t address); // Entry to fill, the pages holding the instruction are watched from now on
+		void flush();
+
+		void onMemoryWrite(uint32_t address);
+
+		// Getters
+		uint64_t getHits();
+		uint64_t getMisses();
+		uint64_t getInvalidations();
+
+	private:
+		RAM* m_ram;
+
+		DecodedInstruction m_entries[DECODE_CACHE_SIZE];
+
+		uint64_t m_hits;
+		uint64_t m_misses;
+		uint64_t m_invalidations;
+};
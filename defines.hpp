@@ -2,10 +2,26 @@
 
 #include <iostream>
 #include <vector>
+#include <unordered_map>
+#ifndef HEADLESS // Headless builds only contain the emulation core, without any SFML dependency
 #include <SFML/Graphics.hpp>
+#endif
 #include <stdint.h>
 #include <string>
+#include <cstring>
 #include <sstream>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#include <atomic>
+
+#define CACHE_LINE_SIZE 64
 
 // SCREEN
 #define WINDOW_WIDTH 1280
@@ -92,5 +108,20 @@
 #define STACK_START_ADDRESS 0x00000000
 #define STACK_END_ADDRESS 0x000000FF
 
+#define VRAM_START_ADDRESS 0x00FFF000 // Text video RAM read by the screen when it is mapped, a character code per cell
+
 std::string uintToString(uint8_t);
 std::string uintToString(uint32_t);
+
+inline unsigned int countTrailingZeros(uint64_t value) // Index of the lowest bit set, value must not be 0
+{
+#ifdef _MSC_VER
+	unsigned long index;
+
+	_BitScanForward64(&index, value);
+
+	return (unsigned int)index;
+#else
+	return (unsigned int)__builtin_ctzll(value);
+#endif
+}
@@ -1,8 +1,18 @@
 #include "device.hpp"
+#include "motherboard.hpp"
 
 Device::Device()
 {
+	m_mb = nullptr;
+	m_firstPort = 0;
+
 	m_INT = false;
+	m_wakeUpCycle = DEVICE_NO_EVENT;
+}
+
+Device::~Device()
+{
+
 }
 
 uint8_t Device::getPortsNumber()
@@ -20,6 +30,11 @@ void Device::setData(uint8_t data, uint8_t portNb)
 	m_ports[portNb] = data;
 }
 
+bool Device::onPortWrite(uint8_t)
+{
+	return true; // Ticked on each write by default
+}
+
 bool Device::getINT()
 {
 	return m_INT;
@@ -27,11 +42,43 @@ bool Device::getINT()
 
 void Device::interruptAcknoledgement()
 {
-	m_INT = false;
+	clearInterrupt();
+}
+
+void Device::plug(Motherboard* mb, uint8_t firstPort)
+{
+	m_mb = mb;
+	m_firstPort = firstPort;
+}
+
+uint64_t Device::getNextEvent()
+{
+	return m_INT ? 0 : DEVICE_NO_EVENT; // Ticked again while its interrupt is up, so it can lower it
+}
+
+uint64_t Device::getWakeUpCycle()
+{
+	return m_wakeUpCycle;
+}
+
+void Device::setWakeUpCycle(uint64_t cycle)
+{
+	m_wakeUpCycle = cycle;
 }
 
 // PRIVATE
 void Device::triggerInterrupt()
 {
 	m_INT = true;
+
+	if (m_mb != nullptr)
+		m_mb->setInterruptPending(m_firstPort, true);
+}
+
+void Device::clearInterrupt()
+{
+	m_INT = false;
+
+	if (m_mb != nullptr)
+		m_mb->setInterruptPending(m_firstPort, false);
 }
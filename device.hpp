@@ -2,23 +2,43 @@
 
 #include "defines.hpp"
 
+class Motherboard;
+
+#define DEVICE_NO_EVENT UINT64_MAX // Only a port write or something from the host (a key hit...) can give the device something to do
+
 class Device
 {
 	public:
 		Device();
+		virtual ~Device();
 
+		virtual void tick() = 0; // Only called by the scheduler, when the device is due
 		uint8_t getPortsNumber();
 
 		uint8_t getData(uint8_t portNb);
 		void setData(uint8_t data, uint8_t portNb);
+		virtual bool onPortWrite(uint8_t portNb); // Called once per write from the CPU, after setData(), returns false if the device has nothing to do about it
 		
 		bool getINT();
 		void interruptAcknoledgement();
 
+		void plug(Motherboard* mb, uint8_t firstPort); // nullptr once unplugged
+
+		virtual uint64_t getNextEvent(); // Cycles after the current tick before the device must tick again (0 = next cycle), DEVICE_NO_EVENT if it has nothing left to do
+
+		// Scheduling
+		uint64_t getWakeUpCycle();
+		void setWakeUpCycle(uint64_t cycle); // DEVICE_NO_EVENT = not scheduled
+
 	protected:
-		void triggerInterrupt();
+		void triggerInterrupt(); // Also flags the interrupt as pending on the motherboard
+		void clearInterrupt();
+
+		Motherboard* m_mb;
+		uint8_t m_firstPort;
 
 		bool m_INT;
+		uint64_t m_wakeUpCycle;
 
 		std::vector<uint8_t> m_ports;
 };
@@ -0,0 +1,17 @@
+#include "display.hpp"
+
+Display::~Display()
+{
+
+}
+
+// NULL DISPLAY
+void NullDisplay::present(const char*, const uint64_t*)
+{
+
+}
+
+bool NullDisplay::pollKeyEvent(uint8_t&, bool&)
+{
+	return false;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "defines.hpp"
+
+#define SCREEN_CHAR_WIDTH 40
+#define SCREEN_CHAR_HEIGHT 25
+#define SCREEN_CELLS_NB (SCREEN_CHAR_WIDTH * SCREEN_CHAR_HEIGHT)
+#define SCREEN_DIRTY_WORDS ((SCREEN_CELLS_NB + 63) / 64) // One bit per cell
+
+// Output surface used by the monitor, so the Screen device doesn't depend on a windowing library
+class Display
+{
+	public:
+		virtual ~Display();
+
+		virtual void present(const char* cells, const uint64_t* dirtyCells) = 0; // SCREEN_CELLS_NB cells, line after line, 0 where nothing is drawn, only the dirty ones changed since the last call
+
+		virtual bool pollKeyEvent(uint8_t& keyCode, bool& pressed) = 0; // Returns false when no key event is waiting, only called from the thread that created the display
+};
+
+// Headless backend : everything drawn is discarded, and no key is ever hit
+class NullDisplay : public Display
+{
+	public:
+		void present(const char* cells, const uint64_t* dirtyCells);
+
+		bool pollKeyEvent(uint8_t& keyCode, bool& pressed);
+};
@@ -0,0 +1,196 @@
+#include "image.hpp"
+#include "logger.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static uint32_t readLittleEndian(const uint8_t* bytes, unsigned int size)
+{
+	uint32_t value(0);
+
+	for (unsigned int i(0); i < size; i++)
+	{
+		value |= (uint32_t)bytes[i] << (8 * i);
+	}
+
+	return value;
+}
+
+ProgramImage::ProgramImage()
+{
+	m_data = nullptr;
+	m_size = 0;
+#ifdef _WIN32
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = nullptr;
+#endif
+}
+
+ProgramImage::~ProgramImage()
+{
+	close();
+}
+
+bool ProgramImage::open(const std::string& path, uint32_t flatLoadAddress)
+{
+	close();
+
+#ifdef _WIN32
+	LARGE_INTEGER fileSize;
+
+	m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (m_file == INVALID_HANDLE_VALUE || !GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		close();
+		return false;
+	}
+
+	m_size = (size_t)fileSize.QuadPart;
+	m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	if (m_mapping != nullptr)
+		m_data = (const uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	int file(::open(path.c_str(), O_RDONLY));
+	struct stat fileStatus;
+
+	if (file < 0)
+		return false;
+
+	if (fstat(file, &fileStatus) == 0 && fileStatus.st_size > 0)
+	{
+		m_size = (size_t)fileStatus.st_size;
+
+		void* data(mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0));
+
+		if (data != MAP_FAILED)
+			m_data = (const uint8_t*)data;
+	}
+
+	::close(file); // The mapping stays valid
+#endif
+
+	if (m_data == nullptr || !parseSegments(flatLoadAddress))
+	{
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+bool ProgramImage::load(RAM* ram)
+{
+	for (unsigned int i(0); i < m_segments.size(); i++)
+	{
+		if (!ram->load(m_data + m_segments[i].fileOffset, m_segments[i].size, m_segments[i].loadAddress))
+			return false;
+	}
+
+	return true;
+}
+
+void ProgramImage::close()
+{
+#ifdef _WIN32
+	if (m_data != nullptr)
+		UnmapViewOfFile(m_data);
+
+	if (m_mapping != nullptr)
+		CloseHandle(m_mapping);
+
+	if (m_file != INVALID_HANDLE_VALUE)
+		CloseHandle(m_file);
+
+	m_file = INVALID_HANDLE_VALUE;
+	m_mapping = nullptr;
+#else
+	if (m_data != nullptr)
+		munmap((void*)m_data, m_size);
+#endif
+
+	m_data = nullptr;
+	m_size = 0;
+	m_segments.clear();
+}
+
+// GETTERS
+const std::vector<ImageSegment>& ProgramImage::getSegments()
+{
+	return m_segments;
+}
+
+uint64_t ProgramImage::getLoadedBytes()
+{
+	uint64_t bytes(0);
+
+	for (unsigned int i(0); i < m_segments.size(); i++)
+	{
+		bytes += m_segments[i].size;
+	}
+
+	return bytes;
+}
+
+// PRIVATE
+bool ProgramImage::parseSegments(uint32_t flatLoadAddress)
+{
+	if (m_size < IMAGE_HEADER_SIZE || memcmp(m_data, IMAGE_MAGIC, 4) != 0) // Flat binary
+	{
+		if (m_size > RAM_SIZE)
+			return false;
+
+		m_segments.push_back({ flatLoadAddress, 0, (uint32_t)m_size });
+
+		return true;
+	}
+
+	unsigned int version(readLittleEndian(m_data + 4, 2)), segmentsNumber(readLittleEndian(m_data + 6, 2));
+
+	if (version != IMAGE_VERSION || m_size < IMAGE_HEADER_SIZE + (size_t)segmentsNumber * IMAGE_SEGMENT_ENTRY_SIZE)
+		return false;
+
+	for (unsigned int i(0); i < segmentsNumber; i++)
+	{
+		const uint8_t* entry(m_data + IMAGE_HEADER_SIZE + i * IMAGE_SEGMENT_ENTRY_SIZE);
+		ImageSegment segment = { readLittleEndian(entry, 4), readLittleEndian(entry + 4, 4), readLittleEndian(entry + 8, 4) };
+
+		if ((uint64_t)segment.fileOffset + segment.size > m_size) // Content outside of the file
+			return false;
+
+		m_segments.push_back(segment);
+	}
+
+	return true;
+}
+
+bool loadProgramImage(RAM* ram, const std::string& path, uint32_t flatLoadAddress)
+{
+	std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+	ProgramImage image;
+
+	if (!image.open(path, flatLoadAddress))
+	{
+		LOG_ERROR("IMAGE", "Unable to open \"" << path << "\" as a program image");
+		return false;
+	}
+
+	if (!image.load(ram))
+	{
+		LOG_ERROR("IMAGE", "A segment of \"" << path << "\" goes past the end of the RAM");
+		return false;
+	}
+
+	double elapsed(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+	LOG_INFO("IMAGE", "\"" << path << "\" : " << image.getSegments().size() << " segments, " << image.getLoadedBytes() << " bytes loaded in " << elapsed * 1000.0 << " ms");
+
+	return true;
+}
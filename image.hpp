@@ -0,0 +1,51 @@
+#pragma once
+
+#include "defines.hpp"
+#include "ram.hpp"
+
+// Program image file :
+// - Segmented image, all the values are little-endian :
+//   "HBC2" magic (4 bytes), version (2 bytes), segments number (2 bytes),
+//   then for each segment : load address (4 bytes), offset of its content in the file (4 bytes), size (4 bytes)
+// - Any other file is a flat binary, copied as a whole at the load address given on the command line
+#define IMAGE_MAGIC "HBC2"
+#define IMAGE_VERSION 1
+#define IMAGE_HEADER_SIZE 8
+#define IMAGE_SEGMENT_ENTRY_SIZE 12
+
+typedef struct
+{
+	uint32_t loadAddress;
+	uint32_t fileOffset;
+	uint32_t size;
+} ImageSegment;
+
+// Read-only mapping of a program image file, only the pages of the segments copied into the RAM are read from the disk
+class ProgramImage
+{
+	public:
+		ProgramImage();
+		~ProgramImage();
+
+		bool open(const std::string& path, uint32_t flatLoadAddress); // False if the file can't be mapped or if its segment table is invalid
+		bool load(RAM* ram); // Copies the segments, false if one of them doesn't fit in the address space
+		void close();
+
+		// Getters
+		const std::vector<ImageSegment>& getSegments();
+		uint64_t getLoadedBytes(); // Sum of the segments sizes
+
+	private:
+		bool parseSegments(uint32_t flatLoadAddress);
+
+		const uint8_t* m_data;
+		size_t m_size;
+#ifdef _WIN32
+		void* m_file;
+		void* m_mapping;
+#endif
+
+		std::vector<ImageSegment> m_segments;
+};
+
+bool loadProgramImage(RAM* ram, const std::string& path, uint32_t flatLoadAddress); // Opens, loads and closes the image, reporting what went wrong
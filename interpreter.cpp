@@ -0,0 +1,570 @@
+#include "cpu.hpp"
+#include "ram.hpp"
+#include "logger.hpp"
+
+// Instruction-level engine : each call runs a whole instruction (or a whole interrupt entry) at once, reading and writing
+// the RAM chip directly instead of going through the buses. The architectural state after each instruction is the same
+// as with the code engine, only the intermediate bus states are skipped.
+
+unsigned int CPU::step()
+{
+	if (m_flags & FLAG_HALT)
+	{
+		m_flags |= FLAG_INTERRUPT; // CPU always ready to handle interrupts when halted
+
+		if (m_mb->getINT()) // Same handshake as the code engine, the IOD chip answers before the interrupt entry
+		{
+			m_step = Step::INTERRUPT_1;
+
+			m_mb->setINR(true);
+			m_flags &= ~FLAG_HALT;
+		}
+
+		return 1;
+	}
+
+	if (m_step == Step::INTERRUPT_1) // Interrupt acknowledged by the IOD chip during the previous call
+		return enterInterrupt();
+
+	if ((m_flags & FLAG_INTERRUPT) && (m_mb->getINT() || m_softwareInterrupt)) // An interrupt has been triggered and the CPU is ready to handle it
+	{
+		m_step = Step::INTERRUPT_1;
+		m_mb->setINR(!m_softwareInterrupt);
+
+		return 1;
+	}
+
+	// Fetch and decode, skipped if the instruction has already been decoded and not overwritten since
+	if (m_decodeCache == nullptr)
+		m_decodeCache = new DecodeCache(m_mb->getRAM());
+
+	const DecodedInstruction* decoded(m_decodeCache->lookup(m_programCounter));
+
+	if (decoded != nullptr)
+		loadDecoded(decoded);
+	else
+	{
+		m_fetchedInstruction = m_mb->read40(m_programCounter);
+
+		decode();
+		saveDecoded(m_decodeCache->allocate(m_programCounter));
+	}
+
+	if (m_codeLength > 0) // Invalid opcode / addressing mode pairs have no code, they execute as NOP
+		execute();
+
+	m_instructionsCount++;
+
+	if (!m_jump)
+	{
+		m_programCounter += 5;
+		if (m_programCounter >= WORK_MEMORY_END_ADDRESS)
+			m_programCounter = 0;
+	}
+	else
+		m_jump = false;
+
+	return m_codeLength + INSTRUCTION_OVERHEAD_CYCLES;
+}
+
+unsigned int CPU::runBlocks(unsigned int maxCycles, bool jit)
+{
+	unsigned int cycles(0);
+	unsigned int first(0); // First instruction of the block left to the interpreter
+
+	if (m_blockCache == nullptr)
+		m_blockCache = new BlockCache(m_mb->getRAM());
+
+	if (jit && m_jitBuffer == nullptr)
+		m_jitBuffer = new JitBuffer();
+
+	// The INT pin only changes when the IOD chip ticks, so interrupts are checked between blocks only (STI always ends a block)
+	while (cycles < maxCycles && !(m_flags & FLAG_HALT) && m_step == Step::FETCH_1 && !((m_flags & FLAG_INTERRUPT) && (m_mb->getINT() || m_softwareInterrupt)))
+	{
+		Block* block(m_blockCache->lookup(m_programCounter));
+
+		if (block == nullptr)
+			block = m_blockCache->insert(translateBlock(m_programCounter));
+
+		first = 0;
+
+		if (jit)
+		{
+			if (++block->runs == JIT_THRESHOLD)
+				compileBlock(block);
+
+			if (block->code != nullptr && block->jitCycles <= maxCycles - cycles) // The compiled code can't stop in the middle of the block
+			{
+				evaluateFlags(); // The compiled code updates the flags register directly
+
+				uint64_t result(((JitBlockFunction)block->code)(this));
+
+				first = (unsigned int)(result & 0xFFFFFFFF);
+				cycles += (unsigned int)(result >> 32);
+				m_instructionsCount += first;
+
+				if (!block->valid) // Exited after overwriting itself
+					continue;
+			}
+		}
+
+		for (unsigned int i(first); i < block->instructions.size() && cycles < maxCycles; i++)
+		{
+			loadDecoded(&block->instructions[i]);
+
+			if (m_codeLength > 0)
+				execute();
+
+			m_instructionsCount++;
+			cycles += m_codeLength + INSTRUCTION_OVERHEAD_CYCLES;
+
+			if (!m_jump)
+			{
+				m_programCounter += 5;
+				if (m_programCounter >= WORK_MEMORY_END_ADDRESS)
+					m_programCounter = 0;
+			}
+			else
+				m_jump = false;
+
+			if (!block->valid) // The block has just overwritten itself, the rest of it is translated again
+				break;
+		}
+	}
+
+	if (cycles == 0) // Halted CPU or interrupt entry, one step at a time
+		cycles = step();
+
+	return cycles;
+}
+
+// PRIVATE
+Block* CPU::translateBlock(uint32_t address)
+{
+	Block* block(new Block());
+	InstructionsList instruction(InstructionsList::NOP);
+	bool blockEnd(false);
+
+	block->address = address;
+
+	while (!blockEnd)
+	{
+		m_fetchedInstruction = m_mb->read40(address);
+
+		decode();
+
+		block->instructions.push_back(DecodedInstruction());
+		saveDecoded(&block->instructions.back());
+		block->instructions.back().address = address;
+
+		address += 5;
+
+		instruction = (InstructionsList)m_opcode;
+
+		switch (instruction)
+		{
+		case InstructionsList::CAL:
+		case InstructionsList::RET:
+		case InstructionsList::IRT:
+		case InstructionsList::INT:
+		case InstructionsList::HLT:
+		case InstructionsList::IN:
+		case InstructionsList::OUT:
+		case InstructionsList::STI:
+			blockEnd = true;
+			break;
+
+		default:
+			blockEnd = (instruction >= InstructionsList::JMC && instruction <= InstructionsList::JMN);
+			break;
+		}
+
+		if (block->instructions.size() >= BLOCK_MAX_INSTRUCTIONS || address >= WORK_MEMORY_END_ADDRESS) // Too long, or the program counter wraps around
+			blockEnd = true;
+	}
+
+	block->endAddress = address;
+
+	return block;
+}
+
+void CPU::execute()
+{
+	AddressingModesList addressingMode((AddressingModesList)m_addressingMode);
+	uint32_t address(addressingMode == AddressingModesList::REG24 ? m_Rx : m_Vx); // Jumps, calls and 24-bit INC / DEC
+
+	switch ((InstructionsList)m_opcode)
+	{
+	case InstructionsList::ADC:
+	case InstructionsList::ADD:
+	case InstructionsList::AND:
+	case InstructionsList::OR:
+	case InstructionsList::SUB:
+	case InstructionsList::XOR:
+		m_accu1 = *m_R1;
+
+		if (addressingMode == AddressingModesList::REG)
+			m_accu2 = *m_R2;
+		else if (addressingMode == AddressingModesList::REG_IMM8)
+			m_accu2 = m_V1;
+		else
+			m_accu2 = readRAM(m_Vx);
+
+		switch ((InstructionsList)m_opcode)
+		{
+		case InstructionsList::ADC:
+			_adc();
+			break;
+
+		case InstructionsList::ADD:
+			_add();
+			break;
+
+		case InstructionsList::AND:
+			_and();
+			break;
+
+		case InstructionsList::OR:
+			_or();
+			break;
+
+		case InstructionsList::SUB:
+			_sub();
+			break;
+
+		case InstructionsList::XOR:
+			_xor();
+			break;
+
+		default: // Only the instructions of the case above get here
+			break;
+		}
+
+		*m_R1 = m_aluOut;
+		break;
+
+	case InstructionsList::CMP:
+		if (addressingMode == AddressingModesList::REG_RAM)
+		{
+			m_accu2 = readRAM(m_Rx);
+			m_accu1 = *m_R4;
+		}
+		else
+		{
+			m_accu1 = *m_R1;
+			m_accu2 = (addressingMode == AddressingModesList::REG) ? *m_R2 : m_V1;
+		}
+
+		_cmp();
+		break;
+
+	case InstructionsList::INC:
+	case InstructionsList::DEC:
+		m_accu1 = (addressingMode == AddressingModesList::REG) ? *m_R1 : readRAM(address);
+		m_accu2 = 0x1;
+
+		if ((InstructionsList)m_opcode == InstructionsList::INC)
+			_add();
+		else
+			_sub();
+
+		if (addressingMode == AddressingModesList::REG)
+			*m_R1 = m_aluOut;
+		else
+			writeRAM(m_aluOut, address);
+		break;
+
+	case InstructionsList::NOT:
+		m_accu1 = (addressingMode == AddressingModesList::REG) ? *m_R1 : readRAM(m_Vx);
+
+		_not();
+
+		if (addressingMode == AddressingModesList::REG)
+			*m_R1 = m_aluOut;
+		else
+			writeRAM(m_aluOut, m_Vx);
+		break;
+
+	case InstructionsList::SHL:
+	case InstructionsList::ASR:
+	case InstructionsList::SHR:
+		m_accu1 = *m_R1;
+
+		if ((InstructionsList)m_opcode == InstructionsList::SHL)
+			_shl();
+		else if ((InstructionsList)m_opcode == InstructionsList::ASR)
+			_asr();
+		else
+			_shr();
+
+		*m_R1 = m_aluOut;
+		break;
+
+	case InstructionsList::CAL:
+		push((uint8_t)(m_programCounter & 0x0000FF));
+		push((uint8_t)((m_programCounter & 0x00FF00) >> 8));
+		push((uint8_t)((m_programCounter & 0xFF0000) >> 16));
+
+		_movPC(address);
+		break;
+
+	case InstructionsList::RET:
+	case InstructionsList::IRT:
+		if ((InstructionsList)m_opcode == InstructionsList::IRT)
+		{
+			_sti();
+			m_registers[(int)Registers::I] = pop();
+		}
+
+		_movPC((uint32_t)pop() << 16);
+		_movPC(((uint32_t)pop() << 8) + m_programCounter);
+		_movPC((uint32_t)pop() + m_programCounter);
+
+		if ((InstructionsList)m_opcode == InstructionsList::RET) // Skipping the CAL instruction
+			_incPC();
+		else // Buses left as by the last code RAM read, a pending software interrupt is entered with them
+		{
+			_movAddBus(m_stackPointer);
+			_movDataBus(readRAM(m_stackPointer));
+		}
+		break;
+
+	case InstructionsList::PSH:
+		push(*m_R1);
+		break;
+
+	case InstructionsList::POP:
+		*m_R1 = pop();
+		break;
+
+	case InstructionsList::STR:
+		if (addressingMode == AddressingModesList::RAMREG_IMMREG)
+			writeRAM(*m_R4, m_Rx);
+		else
+			writeRAM(*m_R1, m_Vx);
+		break;
+
+	case InstructionsList::LOD:
+		if (addressingMode == AddressingModesList::RAMREG_IMMREG)
+			*m_R4 = readRAM(m_Rx);
+		else
+			*m_R1 = readRAM(m_Vx);
+		break;
+
+	case InstructionsList::MOV:
+		*m_R1 = (addressingMode == AddressingModesList::REG) ? *m_R2 : m_V1;
+		break;
+
+	case InstructionsList::IN: // The I/O ports are accessed directly, the IOD chip only handles interrupts in this engine
+		_movAddBus(*m_R2);
+
+		if (m_mb->getDevice(*m_R2) != nullptr)
+			_movDataBus(m_mb->getPortData(*m_R2));
+		else
+			_movDataBus(m_Ex); // Nothing answers, the last byte fetched is still on the data bus
+
+		*m_R1 = m_mb->getDataBus();
+		break;
+
+	case InstructionsList::OUT:
+		_movDataBus(*m_R2);
+		_movAddBus(*m_R1);
+
+		if (m_mb->getDevice(*m_R1) != nullptr)
+			m_mb->setPortData(*m_R2, *m_R1);
+		break;
+
+	case InstructionsList::INT:
+		_movAddBus(m_V1);
+		_movDataBus(m_Ex); // Last byte fetched, as left on the data bus by the code engine
+		_interrupt();
+		break;
+
+	case InstructionsList::HLT:
+		_sth();
+		m_flags |= FLAG_INTERRUPT; // Done by the code engine while ending the instruction
+		break;
+
+	case InstructionsList::JMC:
+		_jmc(address);
+		break;
+
+	case InstructionsList::JME:
+		_jme(address);
+		break;
+
+	case InstructionsList::JMF:
+		_jmf(address);
+		break;
+
+	case InstructionsList::JMK:
+		_jmk(address);
+		break;
+
+	case InstructionsList::JMP:
+		_jmp(address);
+		break;
+
+	case InstructionsList::JMS:
+		_jms(address);
+		break;
+
+	case InstructionsList::JMZ:
+		_jmz(address);
+		break;
+
+	case InstructionsList::JMN:
+		_jmn(address);
+		break;
+
+	case InstructionsList::CLC:
+		_clc();
+		break;
+
+	case InstructionsList::CLE:
+		_cle();
+		break;
+
+	case InstructionsList::CLI:
+		_cli();
+		break;
+
+	case InstructionsList::CLN:
+		_cln();
+		break;
+
+	case InstructionsList::CLS:
+		_cls();
+		break;
+
+	case InstructionsList::CLZ:
+		_clz();
+		break;
+
+	case InstructionsList::CLF:
+		_clf();
+		break;
+
+	case InstructionsList::STC:
+		_stc();
+		break;
+
+	case InstructionsList::STI:
+		_sti();
+		_movAddBus(m_programCounter + 4); // Buses left as by the fetch, a pending software interrupt is entered with them
+		_movDataBus(m_Ex);
+		break;
+
+	case InstructionsList::STN:
+		_stn();
+		break;
+
+	case InstructionsList::STF:
+		_stf();
+		break;
+
+	case InstructionsList::STS:
+		_sts();
+		break;
+
+	case InstructionsList::STE:
+		_ste();
+		break;
+
+	case InstructionsList::STZ:
+		_stz();
+		break;
+
+	default: // NOP, nothing to do
+		break;
+	}
+}
+
+unsigned int CPU::enterInterrupt() // Same as INTERRUPT_1 to INTERRUPT_8 in the code engine
+{
+	m_mb->setINR(false);
+
+	m_flags &= ~FLAG_INTERRUPT;
+
+	m_interruptPort = (uint8_t)(m_mb->getAddressBus() & 0x000000FF);
+	m_interruptData = m_mb->getDataBus();
+	LOG_DEBUG("CPU", "Interrupt data : " << uintToString(m_interruptData));
+
+	push((uint8_t)(m_programCounter & 0x000000FF));
+	push((uint8_t)((m_programCounter & 0x0000FF00) >> 8));
+	push((uint8_t)((m_programCounter & 0x00FF0000) >> 16));
+
+	if (!m_softwareInterrupt) // Pushes I register on the stack if it is not a software interrupt
+		push(m_registers[(int)Registers::I]);
+	else
+		m_softwareInterrupt = false;
+
+	m_registers[(int)Registers::I] = m_interruptData;
+
+	m_interruptVector = ((uint32_t)readRAM(0x000100 + 3 * (uint32_t)(m_interruptPort))) << 16;
+	m_interruptVector += ((uint32_t)readRAM(0x000101 + 3 * (uint32_t)(m_interruptPort))) << 8;
+	m_interruptVector += (uint32_t)readRAM(0x000102 + 3 * (uint32_t)(m_interruptPort));
+
+	m_programCounter = m_interruptVector;
+
+	m_step = Step::FETCH_1;
+
+	return 8;
+}
+
+void CPU::saveDecoded(DecodedInstruction* decoded)
+{
+	decoded->instruction = m_fetchedInstruction;
+	decoded->opcode = m_opcode;
+	decoded->addressingMode = m_addressingMode;
+	decoded->R1 = (uint8_t)(m_R1 - m_registers);
+	decoded->R2 = (uint8_t)(m_R2 - m_registers);
+	decoded->R3 = (uint8_t)(m_R3 - m_registers);
+	decoded->R4 = (uint8_t)(m_R4 - m_registers);
+	decoded->V1 = m_V1;
+	decoded->V2 = m_V2;
+	decoded->Ex = m_Ex;
+	decoded->Vx = m_Vx;
+	decoded->codeStart = m_codeStart;
+	decoded->codeLength = m_codeLength;
+}
+
+void CPU::loadDecoded(const DecodedInstruction* decoded)
+{
+	m_fetchedInstruction = decoded->instruction;
+	m_opcode = decoded->opcode;
+	m_addressingMode = decoded->addressingMode;
+	m_R1 = &m_registers[decoded->R1];
+	m_R2 = &m_registers[decoded->R2];
+	m_R3 = &m_registers[decoded->R3];
+	m_R4 = &m_registers[decoded->R4];
+	m_V1 = decoded->V1;
+	m_V2 = decoded->V2;
+	m_Ex = decoded->Ex;
+	m_Vx = decoded->Vx;
+	m_Rx = ((uint32_t)(*m_R1) << 16) + ((uint32_t)(*m_R2) << 8) + (uint32_t)(*m_R3); // Depends on the registers content, never cached
+	m_codeStart = decoded->codeStart;
+	m_codeLength = decoded->codeLength;
+}
+
+uint8_t CPU::readRAM(uint32_t address)
+{
+	return m_mb->read8(address);
+}
+
+void CPU::writeRAM(uint8_t data, uint32_t address)
+{
+	m_mb->write8(data, address);
+}
+
+void CPU::push(uint8_t data)
+{
+	writeRAM(data, m_stackPointer);
+	_incSTK();
+}
+
+uint8_t CPU::pop()
+{
+	_decSTK();
+	return readRAM(m_stackPointer);
+}
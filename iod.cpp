@@ -1,25 +1,42 @@
 #include "iod.hpp"
+#include "logger.hpp"
 
 IOD::IOD(Motherboard* mb)
 {
 	m_mb = mb;
+
+	m_enqueuedInterrupts = 0;
+	m_deliveredInterrupts = 0;
+	m_droppedInterrupts = 0;
+	m_highWaterMark = 0;
 }
 
 void IOD::tick()
 {
-	for (unsigned int i(0); i < PORTS_NB; i++) // Checking for interrupts from plugged devices
+	uint64_t pendingWords(m_mb->getPendingInterruptWords());
+
+	while (pendingWords != 0) // Checking for interrupts from plugged devices, only the ports flagged as pending are visited
 	{
-		Device* dev(m_mb->getDevice(i));
+		unsigned int word(countTrailingZeros(pendingWords));
+		uint64_t pending(m_mb->getPendingInterrupts(word));
+
+		pendingWords &= pendingWords - 1;
 
-		if (dev != nullptr)
+		while (pending != 0)
 		{
-			if (dev->getINT())
+			uint8_t port((uint8_t)(word * 64 + countTrailingZeros(pending)));
+
+			pending &= pending - 1; // Next one
+
+			if (m_interruptsQueue.push(std::pair<uint8_t, uint8_t>(port, m_mb->getPortData(port))))
 			{
-				if (m_interruptsQueue.size() < INTERRUPT_QUEUE_SIZE) // If the queue is full, new interrupts are discarded
-				{
-					m_interruptsQueue.push_back(std::pair<uint8_t, uint8_t>(i, m_mb->getPortData(i)));
-				}
+				m_enqueuedInterrupts++;
+
+				if (m_interruptsQueue.size() > m_highWaterMark)
+					m_highWaterMark = (unsigned int)m_interruptsQueue.size();
 			}
+			else // If the queue is full, new interrupts are discarded
+				m_droppedInterrupts++;
 		}
 	}
 
@@ -31,11 +48,14 @@ void IOD::tick()
 	{
 		m_mb->setINT(false);
 
-		m_mb->setAddressBus(m_interruptsQueue[0].first);
-		m_mb->setDataBus(m_interruptsQueue[0].second);
-		std::cout << "[IOD] : Interrupt data : " << uintToString(m_interruptsQueue[0].second) << std::endl;
+		std::pair<uint8_t, uint8_t> interrupt(0x00, 0x00);
 
-		m_interruptsQueue.erase(m_interruptsQueue.begin());
+		m_interruptsQueue.pop(interrupt);
+		m_deliveredInterrupts++;
+
+		m_mb->setAddressBus(interrupt.first);
+		m_mb->setDataBus(interrupt.second);
+		LOG_DEBUG("IOD", "Interrupt data : " << uintToString(interrupt.second));
 	}
 	else if (m_mb->getIE()) // CPU asking for data access on a I/O port, which it cannot do while handling an interrupt TODO : I'm not sure about that last sentence
 	{
@@ -49,7 +69,7 @@ void IOD::tick()
 			}
 			else // CPU asking to read data
 			{
-				m_mb->getPortData(address);
+				m_mb->setDataBus(m_mb->getPortData(address));
 			}
 		}
 
@@ -58,7 +78,32 @@ void IOD::tick()
 }
 
 // GETTERS
-uint8_t IOD::getStackCount()
+unsigned int IOD::getStackCount()
+{
+	return (unsigned int)m_interruptsQueue.size();
+}
+
+bool IOD::isIdle()
+{
+	return m_interruptsQueue.empty() && !m_mb->getINT() && !m_mb->getIE() && !m_mb->hasPendingInterrupts();
+}
+
+uint64_t IOD::getEnqueuedInterrupts()
+{
+	return m_enqueuedInterrupts;
+}
+
+uint64_t IOD::getDeliveredInterrupts()
+{
+	return m_deliveredInterrupts;
+}
+
+uint64_t IOD::getDroppedInterrupts()
+{
+	return m_droppedInterrupts;
+}
+
+unsigned int IOD::getHighWaterMark()
 {
-	return (uint8_t)m_interruptsQueue.size();
+	return m_highWaterMark;
 }
@@ -3,21 +3,36 @@
 #include "defines.hpp"
 #include "device.hpp"
 #include "motherboard.hpp"
+#include "ringbuffer.hpp"
 
-#define INTERRUPT_QUEUE_SIZE 256
+#define INTERRUPT_QUEUE_SIZE 256 // Power of two
 
 class IOD
 {
 	public:
 		IOD(Motherboard* mb);
 
+		CACHE_ALIGNED_NEW
+
 		void tick();
 
 		// GETTERS
-		uint8_t getStackCount();
+		unsigned int getStackCount();
+		bool isIdle(); // No interrupt raised or waiting, and no I/O access in progress
+
+		// Interrupts statistics, to size the queue
+		uint64_t getEnqueuedInterrupts();
+		uint64_t getDeliveredInterrupts();
+		uint64_t getDroppedInterrupts(); // Raised while the queue was full
+		unsigned int getHighWaterMark(); // Most interrupts ever waiting at once
 
 	private:
 		Motherboard* m_mb;
 
-		std::vector<std::pair<uint8_t, uint8_t>> m_interruptsQueue; // Pair of uint8_t, the first being the I/O port number and the second being the data sent by the device
+		RingBuffer<std::pair<uint8_t, uint8_t>, INTERRUPT_QUEUE_SIZE> m_interruptsQueue; // Pair of uint8_t, the first being the I/O port number and the second being the data sent by the device
+
+		uint64_t m_enqueuedInterrupts;
+		uint64_t m_deliveredInterrupts;
+		uint64_t m_droppedInterrupts;
+		unsigned int m_highWaterMark;
 };
@@ -0,0 +1,914 @@
+#include "cpu.hpp"
+#include "ram.hpp"
+#include "logger.hpp"
+#include <cstring>
+#include <cassert>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+// JIT BUFFER
+JitBuffer::JitBuffer()
+{
+	m_used = 0;
+
+#if !defined(JIT_AVAILABLE)
+	m_memory = nullptr;
+#elif defined(_WIN32)
+	m_memory = (uint8_t*)VirtualAlloc(nullptr, JIT_BUFFER_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+#else
+	m_memory = (uint8_t*)mmap(nullptr, JIT_BUFFER_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (m_memory == MAP_FAILED)
+		m_memory = nullptr;
+#endif
+
+	if (m_memory == nullptr)
+		LOG_WARNING("JIT", "No executable memory available, blocks won't be compiled");
+	else
+		setWritable(false);
+}
+
+JitBuffer::~JitBuffer()
+{
+	if (m_memory != nullptr)
+	{
+#ifdef _WIN32
+		VirtualFree(m_memory, 0, MEM_RELEASE);
+#else
+		munmap(m_memory, JIT_BUFFER_SIZE);
+#endif
+	}
+}
+
+void* JitBuffer::install(const std::vector<uint8_t>& code)
+{
+	if (m_memory == nullptr || m_used + code.size() > JIT_BUFFER_SIZE)
+		return nullptr;
+
+	uint8_t* entry(m_memory + m_used);
+
+	setWritable(true);
+	memcpy(entry, code.data(), code.size());
+	setWritable(false);
+
+	m_used += (code.size() + 15) & ~(size_t)15; // Entries aligned on 16 bytes
+
+	return entry;
+}
+
+// PRIVATE
+void JitBuffer::setWritable(bool writable) // Never writable and executable at the same time
+{
+#if defined(_WIN32)
+	DWORD oldProtection;
+
+	VirtualProtect(m_memory, JIT_BUFFER_SIZE, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &oldProtection);
+#else
+	mprotect(m_memory, JIT_BUFFER_SIZE, writable ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC));
+#endif
+}
+
+#ifdef JIT_AVAILABLE
+enum class X64Register : uint8_t {EAX = 0, ECX = 1, EDX = 2}; // Only scratch registers, rbx holds the CPU, r12 the RAM content and r13 the watched pages bitmap
+enum class X64Condition : uint8_t {BELOW = 0x2, ZERO = 0x4, NOT_ZERO = 0x5, BELOW_EQUAL = 0x6, ABOVE = 0x7, SIGN = 0x8};
+enum class X64AluOperation : uint8_t {ADD = 0x00, OR = 0x08, ADC = 0x10, AND = 0x20, SUB = 0x28, XOR = 0x30, CMP = 0x38};
+enum class X64Shift : uint8_t {SHL = 0xE0, SHR = 0xE8, SAR = 0xF8};
+
+// Encodes the few x86-64 instructions the compiled blocks are made of
+class X64Emitter
+{
+	public:
+		std::vector<uint8_t> code;
+
+		void prologue()
+		{
+			emit({ 0x53, 0x41, 0x54, 0x41, 0x55 }); // push rbx, push r12, push r13 (the stack is now 16 bytes aligned)
+#ifdef _WIN32
+			emit({ 0x48, 0x83, 0xEC, 0x20 }); // sub rsp, 32 (shadow space)
+			emit({ 0x48, 0x89, 0xCB }); // mov rbx, rcx
+#else
+			emit({ 0x48, 0x89, 0xFB }); // mov rbx, rdi
+#endif
+		}
+
+		void epilogue()
+		{
+#ifdef _WIN32
+			emit({ 0x48, 0x83, 0xC4, 0x20 }); // add rsp, 32
+#endif
+			emit({ 0x41, 0x5D, 0x41, 0x5C, 0x5B, 0xC3 }); // pop r13, pop r12, pop rbx, ret
+		}
+
+		void setBases(const uint8_t* memory, const uint64_t* watchedPages)
+		{
+			emit({ 0x49, 0xBC }); // mov r12, imm64
+			imm64((uint64_t)memory);
+			emit({ 0x49, 0xBD }); // mov r13, imm64
+			imm64((uint64_t)watchedPages);
+		}
+
+		void exit(uint32_t cycles, uint32_t instructions)
+		{
+			emit({ 0x48, 0xB8 }); // mov rax, imm64
+			imm64(((uint64_t)cycles << 32) | instructions);
+			epilogue();
+		}
+
+		// CPU fields, addressed from rbx
+		void loadByte(X64Register reg, int32_t field) // movzx r32, byte [rbx + field]
+		{
+			emit({ 0x0F, 0xB6, modRMField(reg) });
+			imm32(field);
+		}
+
+		void storeByte(X64Register reg, int32_t field) // mov byte [rbx + field], r8
+		{
+			emit({ 0x88, modRMField(reg) });
+			imm32(field);
+		}
+
+		void storeByte(uint8_t value, int32_t field) // mov byte [rbx + field], imm8
+		{
+			emit({ 0xC6, 0x83 });
+			imm32(field);
+			byte(value);
+		}
+
+		void andByte(int32_t field, uint8_t value) // and byte [rbx + field], imm8
+		{
+			emit({ 0x80, 0xA3 });
+			imm32(field);
+			byte(value);
+		}
+
+		void orByte(int32_t field, uint8_t value) // or byte [rbx + field], imm8
+		{
+			emit({ 0x80, 0x8B });
+			imm32(field);
+			byte(value);
+		}
+
+		void orByte(X64Register reg, int32_t field) // or byte [rbx + field], r8
+		{
+			emit({ 0x08, modRMField(reg) });
+			imm32(field);
+		}
+
+		void testByte(int32_t field, uint8_t value) // test byte [rbx + field], imm8
+		{
+			emit({ 0xF6, 0x83 });
+			imm32(field);
+			byte(value);
+		}
+
+		void loadDword(X64Register reg, int32_t field) // mov r32, dword [rbx + field]
+		{
+			emit({ 0x8B, modRMField(reg) });
+			imm32(field);
+		}
+
+		void storeDword(X64Register reg, int32_t field) // mov dword [rbx + field], r32
+		{
+			emit({ 0x89, modRMField(reg) });
+			imm32(field);
+		}
+
+		void storeDword(uint32_t value, int32_t field) // mov dword [rbx + field], imm32
+		{
+			emit({ 0xC7, 0x83 });
+			imm32(field);
+			imm32(value);
+		}
+
+		void incrementDword(int32_t field) // inc dword [rbx + field]
+		{
+			emit({ 0xFF, 0x83 });
+			imm32(field);
+		}
+
+		void decrementDword(int32_t field) // dec dword [rbx + field]
+		{
+			emit({ 0xFF, 0x8B });
+			imm32(field);
+		}
+
+		// Scratch registers
+		void moveImmediate8(X64Register reg, uint8_t value) // mov r8, imm8
+		{
+			emit({ (uint8_t)(0xB0 + (uint8_t)reg), value });
+		}
+
+		void moveImmediate32(X64Register reg, uint32_t value) // mov r32, imm32
+		{
+			byte(0xB8 + (uint8_t)reg);
+			imm32(value);
+		}
+
+		void move32(X64Register dst, X64Register src) // mov r32, r32
+		{
+			emit({ 0x89, modRMRegister(src, dst) });
+		}
+
+		void alu8(X64AluOperation operation, X64Register dst, X64Register src) // op r8, r8
+		{
+			emit({ (uint8_t)operation, modRMRegister(src, dst) });
+		}
+
+		void xorImmediate8(X64Register reg, uint8_t value) // xor r8, imm8
+		{
+			emit({ 0x80, (uint8_t)(0xF0 | (uint8_t)reg), value });
+		}
+
+		void andImmediate8(X64Register reg, uint8_t value) // and r8, imm8
+		{
+			emit({ 0x80, (uint8_t)(0xE0 | (uint8_t)reg), value });
+		}
+
+		void shiftLeft8(X64Register reg, uint8_t count) // shl r8, imm8
+		{
+			emit({ 0xC0, (uint8_t)(0xE0 | (uint8_t)reg), count });
+		}
+
+		void shiftRight8(X64Register reg, uint8_t count) // shr r8, imm8
+		{
+			emit({ 0xC0, (uint8_t)(0xE8 | (uint8_t)reg), count });
+		}
+
+		void setRegister(X64Condition condition, X64Register reg) // setcc r8
+		{
+			emit({ 0x0F, (uint8_t)(0x90 | (uint8_t)condition), (uint8_t)(0xC0 | (uint8_t)reg) });
+		}
+
+		void saveFlags(X64Register reg) // pushfq, pop r64 (carry in bit 0, zero in bit 6, sign in bit 7)
+		{
+			emit({ 0x9C, (uint8_t)(0x58 + (uint8_t)reg) });
+		}
+
+		void test8(X64Register reg) // test r8, r8
+		{
+			emit({ 0x84, modRMRegister(reg, reg) });
+		}
+
+		void shift8(X64Shift shift, X64Register reg) // shl / shr / sar r8, 1
+		{
+			emit({ 0xD0, (uint8_t)((uint8_t)shift | (uint8_t)reg) });
+		}
+
+		void setCarry() // stc
+		{
+			byte(0xF9);
+		}
+
+		void shiftLeft32(X64Register reg, uint8_t count) // shl r32, imm8
+		{
+			emit({ 0xC1, (uint8_t)(0xE0 | (uint8_t)reg), count });
+		}
+
+		void or32(X64Register dst, X64Register src) // or r32, r32
+		{
+			emit({ 0x09, modRMRegister(src, dst) });
+		}
+
+		void add32(X64Register dst, X64Register src) // add r32, r32
+		{
+			emit({ 0x01, modRMRegister(src, dst) });
+		}
+
+		void addImmediate32(X64Register reg, uint32_t value) // add r32, imm32
+		{
+			emit({ 0x81, (uint8_t)(0xC0 | (uint8_t)reg) });
+			imm32(value);
+		}
+
+		void andImmediate32(X64Register reg, uint32_t value) // and r32, imm32
+		{
+			emit({ 0x81, (uint8_t)(0xE0 | (uint8_t)reg) });
+			imm32(value);
+		}
+
+		void compareImmediate32(X64Register reg, uint32_t value) // cmp r32, imm32
+		{
+			emit({ 0x81, (uint8_t)(0xF8 | (uint8_t)reg) });
+			imm32(value);
+		}
+
+		void clear32(X64Register reg) // xor r32, r32
+		{
+			emit({ 0x31, modRMRegister(reg, reg) });
+		}
+
+		// RAM content, addressed from r12 with the address in edx
+		void readRAM(X64Register reg) // movzx r32, byte [r12 + rdx]
+		{
+			emit({ 0x41, 0x0F, 0xB6, (uint8_t)(0x04 | ((uint8_t)reg << 3)), 0x14 });
+		}
+
+		void writeRAM(RAM* ram, void (*slowWrite)(RAM*, uint32_t, uint8_t)) // Writes al at edx, through the RAM chip if the page is watched
+		{
+			move32(X64Register::ECX, X64Register::EDX);
+			emit({ 0xC1, 0xE9, 0x08 }); // shr ecx, 8 (page)
+			emit({ 0x41, 0x0F, 0xA3, 0x4D, 0x00 }); // bt [r13], ecx
+			size_t watched(jump(X64Condition::BELOW));
+
+			emit({ 0x41, 0x88, 0x04, 0x14 }); // mov byte [r12 + rdx], al
+			size_t done(jump());
+
+			bind(watched);
+#ifdef _WIN32
+			emit({ 0x44, 0x0F, 0xB6, 0xC0 }); // movzx r8d, al
+			emit({ 0x48, 0xB9 }); // mov rcx, imm64
+			imm64((uint64_t)ram);
+#else
+			emit({ 0x89, 0xD6 }); // mov esi, edx
+			emit({ 0x0F, 0xB6, 0xD0 }); // movzx edx, al
+			emit({ 0x48, 0xBF }); // mov rdi, imm64
+			imm64((uint64_t)ram);
+#endif
+			emit({ 0x48, 0xB8 }); // mov rax, imm64
+			imm64((uint64_t)slowWrite);
+			emit({ 0xFF, 0xD0 }); // call rax
+
+			bind(done);
+		}
+
+		void compareAbsoluteByte(const void* address, uint8_t value) // cmp byte [imm64], imm8
+		{
+			emit({ 0x48, 0xB8 }); // mov rax, imm64
+			imm64((uint64_t)address);
+			emit({ 0x80, 0x38, value }); // cmp byte [rax], imm8
+		}
+
+		// Jumps, bound once their target is known
+		size_t jump(X64Condition condition) // jcc rel32
+		{
+			emit({ 0x0F, (uint8_t)(0x80 | (uint8_t)condition) });
+			imm32(0);
+
+			return code.size();
+		}
+
+		size_t jump() // jmp rel32
+		{
+			byte(0xE9);
+			imm32(0);
+
+			return code.size();
+		}
+
+		void bind(size_t jumpEnd) // The jump ending at this offset lands here
+		{
+			uint32_t offset((uint32_t)(code.size() - jumpEnd));
+
+			memcpy(&code[jumpEnd - 4], &offset, 4);
+		}
+
+	private:
+		void byte(uint8_t b)
+		{
+			code.push_back(b);
+		}
+
+		void emit(std::initializer_list<uint8_t> bytes)
+		{
+			code.insert(code.end(), bytes);
+		}
+
+		void imm32(uint32_t v)
+		{
+			for (unsigned int i(0); i < 4; i++)
+			{
+				byte((uint8_t)(v >> (8 * i)));
+			}
+		}
+
+		void imm64(uint64_t v)
+		{
+			imm32((uint32_t)v);
+			imm32((uint32_t)(v >> 32));
+		}
+
+		static uint8_t modRMField(X64Register reg) // [rbx + disp32]
+		{
+			return 0x83 | ((uint8_t)reg << 3);
+		}
+
+		static uint8_t modRMRegister(X64Register reg, X64Register rm)
+		{
+			return 0xC0 | ((uint8_t)reg << 3) | (uint8_t)rm;
+		}
+};
+
+static void jitWriteRAM(RAM* ram, uint32_t address, uint8_t data) // Writes into watched pages notify the caches, which may invalidate the running block
+{
+	ram->setData(data, address);
+}
+#endif
+
+// Compiles the longest prefix of the block made of supported instructions. IN, OUT, INT, IRT, HLT and STI are left to the
+// interpreter, like the invalid instructions. Every instruction reads its operands from the CPU fields and writes its
+// results back, so the generated code can exit after any instruction with the CPU in the same state as the interpreter.
+void CPU::compileBlock(Block* block)
+{
+#ifdef JIT_AVAILABLE
+	X64Emitter x64;
+	RAM* ram(m_mb->getRAM());
+	uint32_t cycles(0);
+	unsigned int compiled(0);
+	uint32_t exitAddress(block->address); // First instruction not compiled
+	bool blockEnd(false);
+
+	const int32_t regs((int32_t)((uint8_t*)m_registers - (uint8_t*)this));
+	const int32_t flags((int32_t)((uint8_t*)&m_flags - (uint8_t*)this));
+	const int32_t accu1((int32_t)((uint8_t*)&m_accu1 - (uint8_t*)this));
+	const int32_t accu2((int32_t)((uint8_t*)&m_accu2 - (uint8_t*)this));
+	const int32_t aluOut((int32_t)((uint8_t*)&m_aluOut - (uint8_t*)this));
+	const int32_t programCounter((int32_t)((uint8_t*)&m_programCounter - (uint8_t*)this));
+	const int32_t stackPointer((int32_t)((uint8_t*)&m_stackPointer - (uint8_t*)this));
+
+	x64.prologue();
+	x64.setBases(ram->getMemory(), ram->getWatchedPages());
+
+	for (unsigned int i(0); i < block->instructions.size() && !blockEnd; i++)
+	{
+		const DecodedInstruction& instruction(block->instructions[i]);
+		InstructionsList opcode((InstructionsList)instruction.opcode);
+		AddressingModesList addressingMode((AddressingModesList)instruction.addressingMode);
+		uint32_t nextAddress(instruction.address + 5);
+		bool memoryWrite(false);
+		bool supported(true);
+
+		if (nextAddress >= WORK_MEMORY_END_ADDRESS)
+			nextAddress = 0;
+
+		if (instruction.codeLength == 0)
+			break;
+
+		// Operand addresses
+		auto loadRx = [&]() // edx = R1 R2 R3
+		{
+			x64.loadByte(X64Register::EDX, regs + instruction.R1);
+			x64.shiftLeft32(X64Register::EDX, 16);
+			x64.loadByte(X64Register::ECX, regs + instruction.R2);
+			x64.shiftLeft32(X64Register::ECX, 8);
+			x64.or32(X64Register::EDX, X64Register::ECX);
+			x64.loadByte(X64Register::ECX, regs + instruction.R3);
+			x64.or32(X64Register::EDX, X64Register::ECX);
+		};
+
+		auto loadAddress = [&]() // edx = Rx or Vx, depending on the addressing mode
+		{
+			if (addressingMode == AddressingModesList::REG24 || addressingMode == AddressingModesList::RAMREG_IMMREG)
+				loadRx();
+			else
+				x64.moveImmediate32(X64Register::EDX, instruction.Vx);
+		};
+
+		auto loadStackAddress = [&]() // edx = stack pointer
+		{
+			x64.loadDword(X64Register::EDX, stackPointer);
+			x64.andImmediate32(X64Register::EDX, 0x00FFFFFF);
+		};
+
+		auto writeRAM = [&]() // al at edx
+		{
+			x64.writeRAM(ram, jitWriteRAM);
+			memoryWrite = true;
+		};
+
+		auto push = [&](uint8_t value)
+		{
+			loadStackAddress();
+			x64.moveImmediate8(X64Register::EAX, value);
+			writeRAM();
+			x64.incrementDword(stackPointer);
+		};
+
+		auto pop = [&]() // eax = popped byte
+		{
+			x64.decrementDword(stackPointer);
+			loadStackAddress();
+			x64.readRAM(X64Register::EAX);
+		};
+
+		auto storeAccumulators = [&]() // al and cl
+		{
+			x64.storeByte(X64Register::EAX, accu1);
+			x64.storeByte(X64Register::ECX, accu2);
+		};
+
+		auto alu = [&](InstructionsList operation) // al = al op cl, with the same flags as the ALU helpers, computed right away
+		{
+			uint8_t updated(FLAG_CARRY | FLAG_ZERO | FLAG_NEGATIVE);
+			bool carryInDl(false); // Otherwise the host carry is the right one
+
+			switch (operation)
+			{
+			case InstructionsList::ADC:
+				x64.setCarry();
+				x64.alu8(X64AluOperation::ADC, X64Register::EAX, X64Register::ECX);
+				break;
+
+			case InstructionsList::ADD:
+			case InstructionsList::INC:
+				x64.alu8(X64AluOperation::ADD, X64Register::EAX, X64Register::ECX);
+				break;
+
+			case InstructionsList::SUB:
+			case InstructionsList::DEC:
+				x64.move32(X64Register::EDX, X64Register::EAX); // The carry of a subtraction is the one of the addition, as in _sub()
+				x64.alu8(X64AluOperation::ADD, X64Register::EDX, X64Register::ECX);
+				x64.setRegister(X64Condition::BELOW, X64Register::EDX);
+				x64.alu8(X64AluOperation::SUB, X64Register::EAX, X64Register::ECX);
+				carryInDl = true;
+				break;
+
+			case InstructionsList::AND:
+				x64.alu8(X64AluOperation::AND, X64Register::EAX, X64Register::ECX);
+				updated = FLAG_ZERO | FLAG_NEGATIVE;
+				break;
+
+			case InstructionsList::OR:
+				x64.alu8(X64AluOperation::OR, X64Register::EAX, X64Register::ECX);
+				updated = FLAG_ZERO | FLAG_NEGATIVE;
+				break;
+
+			case InstructionsList::XOR:
+				x64.alu8(X64AluOperation::XOR, X64Register::EAX, X64Register::ECX);
+				updated = FLAG_ZERO | FLAG_NEGATIVE;
+				break;
+
+			case InstructionsList::NOT:
+				x64.xorImmediate8(X64Register::EAX, 0xFF); // Unlike not, sets the zero and sign flags
+				updated = FLAG_ZERO | FLAG_NEGATIVE;
+				break;
+
+			case InstructionsList::SHL:
+				x64.shift8(X64Shift::SHL, X64Register::EAX);
+				break;
+
+			case InstructionsList::SHR:
+			case InstructionsList::ASR:
+				x64.move32(X64Register::EDX, X64Register::EAX); // Carry = sign bit of the operand, as in _shr() and _asr()
+				x64.alu8(X64AluOperation::ADD, X64Register::EDX, X64Register::EDX);
+				x64.setRegister(X64Condition::BELOW, X64Register::EDX);
+				x64.shift8((operation == InstructionsList::SHR) ? X64Shift::SHR : X64Shift::SAR, X64Register::EAX);
+				carryInDl = true;
+				break;
+
+			default: // The callers only pass ALU instructions
+				assert(false && "Not an ALU instruction");
+				break;
+			}
+
+			x64.saveFlags(X64Register::ECX); // Same bits as the flags register for the carry, zero and negative flags
+
+			if (carryInDl)
+			{
+				x64.andImmediate8(X64Register::ECX, FLAG_ZERO | FLAG_NEGATIVE);
+				x64.alu8(X64AluOperation::OR, X64Register::ECX, X64Register::EDX);
+			}
+			else
+				x64.andImmediate8(X64Register::ECX, updated);
+
+			x64.andByte(flags, (uint8_t)~updated);
+			x64.orByte(X64Register::ECX, flags);
+			x64.storeByte(X64Register::EAX, aluOut);
+		};
+
+		auto conditionalJump = [&](uint8_t flag) // Block end
+		{
+			x64.testByte(flags, flag);
+			size_t notTaken(x64.jump(X64Condition::ZERO));
+
+			loadAddress();
+			x64.storeDword(X64Register::EDX, programCounter);
+			x64.exit(cycles + instruction.codeLength + INSTRUCTION_OVERHEAD_CYCLES, compiled + 1);
+
+			x64.bind(notTaken);
+			x64.storeDword(nextAddress, programCounter);
+		};
+
+		switch (opcode)
+		{
+		case InstructionsList::ADC:
+		case InstructionsList::ADD:
+		case InstructionsList::AND:
+		case InstructionsList::OR:
+		case InstructionsList::SUB:
+		case InstructionsList::XOR:
+			if (addressingMode == AddressingModesList::REG)
+				x64.loadByte(X64Register::ECX, regs + instruction.R2);
+			else if (addressingMode == AddressingModesList::REG_IMM8)
+				x64.moveImmediate8(X64Register::ECX, instruction.V1);
+			else
+			{
+				x64.moveImmediate32(X64Register::EDX, instruction.Vx);
+				x64.readRAM(X64Register::ECX);
+			}
+
+			x64.loadByte(X64Register::EAX, regs + instruction.R1);
+			storeAccumulators();
+			alu(opcode);
+			x64.storeByte(X64Register::EAX, regs + instruction.R1);
+			break;
+
+		case InstructionsList::CMP:
+			if (addressingMode == AddressingModesList::REG_RAM)
+			{
+				loadRx();
+				x64.readRAM(X64Register::ECX);
+				x64.loadByte(X64Register::EAX, regs + instruction.R4);
+			}
+			else
+			{
+				if (addressingMode == AddressingModesList::REG)
+					x64.loadByte(X64Register::ECX, regs + instruction.R2);
+				else
+					x64.moveImmediate8(X64Register::ECX, instruction.V1);
+
+				x64.loadByte(X64Register::EAX, regs + instruction.R1);
+			}
+
+			storeAccumulators();
+			x64.alu8(X64AluOperation::CMP, X64Register::EAX, X64Register::ECX);
+			x64.saveFlags(X64Register::ECX); // Host carry = inferior, host zero = equal
+			x64.test8(X64Register::EAX);
+			x64.setRegister(X64Condition::ZERO, X64Register::EDX);
+			x64.shiftLeft8(X64Register::EDX, 6); // dl = zero flag
+
+			x64.move32(X64Register::EAX, X64Register::ECX);
+			x64.andImmediate8(X64Register::EAX, 0x01);
+			x64.shiftLeft8(X64Register::EAX, 2);
+			x64.alu8(X64AluOperation::OR, X64Register::EDX, X64Register::EAX); // Inferior
+
+			x64.move32(X64Register::EAX, X64Register::ECX);
+			x64.shiftRight8(X64Register::EAX, 2);
+			x64.andImmediate8(X64Register::EAX, FLAG_EQUAL);
+			x64.alu8(X64AluOperation::OR, X64Register::EDX, X64Register::EAX); // Equal
+
+			x64.andImmediate8(X64Register::ECX, 0x41);
+			x64.setRegister(X64Condition::ZERO, X64Register::EAX);
+			x64.shiftLeft8(X64Register::EAX, 3);
+			x64.alu8(X64AluOperation::OR, X64Register::EDX, X64Register::EAX); // Superior, neither inferior nor equal
+
+			x64.andByte(flags, (uint8_t)~(FLAG_ZERO | FLAG_EQUAL | FLAG_INFERIOR | FLAG_SUPERIOR));
+			x64.orByte(X64Register::EDX, flags);
+			break;
+
+		case InstructionsList::INC:
+		case InstructionsList::DEC:
+		case InstructionsList::NOT:
+			if (addressingMode == AddressingModesList::REG)
+				x64.loadByte(X64Register::EAX, regs + instruction.R1);
+			else
+			{
+				loadAddress();
+				x64.readRAM(X64Register::EAX);
+			}
+
+			if (opcode == InstructionsList::NOT)
+				x64.storeByte(X64Register::EAX, accu1);
+			else
+			{
+				x64.moveImmediate8(X64Register::ECX, 0x1);
+				storeAccumulators();
+			}
+
+			alu(opcode);
+
+			if (addressingMode == AddressingModesList::REG)
+				x64.storeByte(X64Register::EAX, regs + instruction.R1);
+			else
+			{
+				loadAddress(); // edx may have been used by the ALU
+				writeRAM();
+			}
+			break;
+
+		case InstructionsList::SHL:
+		case InstructionsList::ASR:
+		case InstructionsList::SHR:
+			x64.loadByte(X64Register::EAX, regs + instruction.R1);
+			x64.storeByte(X64Register::EAX, accu1);
+			alu(opcode);
+			x64.storeByte(X64Register::EAX, regs + instruction.R1);
+			break;
+
+		case InstructionsList::MOV:
+			if (addressingMode == AddressingModesList::REG)
+			{
+				x64.loadByte(X64Register::EAX, regs + instruction.R2);
+				x64.storeByte(X64Register::EAX, regs + instruction.R1);
+			}
+			else
+				x64.storeByte(instruction.V1, regs + instruction.R1);
+			break;
+
+		case InstructionsList::LOD:
+			loadAddress();
+			x64.readRAM(X64Register::EAX);
+			x64.storeByte(X64Register::EAX, regs + ((addressingMode == AddressingModesList::RAMREG_IMMREG) ? instruction.R4 : instruction.R1));
+			break;
+
+		case InstructionsList::STR:
+			loadAddress();
+			x64.loadByte(X64Register::EAX, regs + ((addressingMode == AddressingModesList::RAMREG_IMMREG) ? instruction.R4 : instruction.R1));
+			writeRAM();
+			break;
+
+		case InstructionsList::PSH:
+			loadStackAddress();
+			x64.loadByte(X64Register::EAX, regs + instruction.R1);
+			writeRAM();
+			x64.incrementDword(stackPointer);
+			break;
+
+		case InstructionsList::POP:
+			pop();
+			x64.storeByte(X64Register::EAX, regs + instruction.R1);
+			break;
+
+		case InstructionsList::CAL: // Block end
+			push((uint8_t)(instruction.address & 0x0000FF));
+			push((uint8_t)((instruction.address & 0x00FF00) >> 8));
+			push((uint8_t)((instruction.address & 0xFF0000) >> 16));
+
+			loadAddress();
+			x64.storeDword(X64Register::EDX, programCounter);
+			memoryWrite = false; // The block ends here anyway
+			blockEnd = true;
+			break;
+
+		case InstructionsList::RET: // Block end
+			pop();
+			x64.shiftLeft32(X64Register::EAX, 16);
+			x64.storeDword(X64Register::EAX, programCounter);
+
+			pop();
+			x64.shiftLeft32(X64Register::EAX, 8);
+			x64.loadDword(X64Register::ECX, programCounter);
+			x64.add32(X64Register::EAX, X64Register::ECX);
+			x64.andImmediate32(X64Register::EAX, 0x00FFFFFF);
+			x64.storeDword(X64Register::EAX, programCounter);
+
+			pop();
+			x64.loadDword(X64Register::ECX, programCounter);
+			x64.add32(X64Register::EAX, X64Register::ECX);
+			x64.andImmediate32(X64Register::EAX, 0x00FFFFFF);
+
+			{
+				x64.addImmediate32(X64Register::EAX, 5); // Skipping the CAL instruction, as in _incPC()
+				x64.compareImmediate32(X64Register::EAX, WORK_MEMORY_END_ADDRESS);
+				size_t inRange(x64.jump(X64Condition::BELOW));
+				x64.clear32(X64Register::EAX);
+				x64.bind(inRange);
+			}
+
+			x64.storeDword(X64Register::EAX, programCounter);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JMP: // Block end
+			loadAddress();
+			x64.storeDword(X64Register::EDX, programCounter);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JMK: // Block end
+			loadAddress();
+			x64.addImmediate32(X64Register::EDX, instruction.address);
+
+			{
+				x64.compareImmediate32(X64Register::EDX, WORK_MEMORY_END_ADDRESS); // As in _jmk()
+				size_t inRange(x64.jump(X64Condition::BELOW_EQUAL));
+				x64.clear32(X64Register::EDX);
+				x64.bind(inRange);
+			}
+
+			x64.storeDword(X64Register::EDX, programCounter);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JMC:
+			conditionalJump(FLAG_CARRY);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JME:
+			conditionalJump(FLAG_EQUAL);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JMF:
+			conditionalJump(FLAG_INFERIOR);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JMS:
+			conditionalJump(FLAG_SUPERIOR);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JMZ:
+			conditionalJump(FLAG_ZERO);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::JMN:
+			conditionalJump(FLAG_NEGATIVE);
+			blockEnd = true;
+			break;
+
+		case InstructionsList::CLC:
+			x64.andByte(flags, (uint8_t)~FLAG_CARRY);
+			break;
+
+		case InstructionsList::CLE:
+			x64.andByte(flags, (uint8_t)~FLAG_EQUAL);
+			break;
+
+		case InstructionsList::CLI:
+			x64.andByte(flags, (uint8_t)~FLAG_INTERRUPT);
+			break;
+
+		case InstructionsList::CLN:
+			x64.andByte(flags, (uint8_t)~FLAG_NEGATIVE);
+			break;
+
+		case InstructionsList::CLS:
+			x64.andByte(flags, (uint8_t)~FLAG_SUPERIOR);
+			break;
+
+		case InstructionsList::CLZ:
+			x64.andByte(flags, (uint8_t)~FLAG_ZERO);
+			break;
+
+		case InstructionsList::CLF:
+			x64.andByte(flags, (uint8_t)~FLAG_INFERIOR);
+			break;
+
+		case InstructionsList::STC:
+			x64.orByte(flags, FLAG_CARRY);
+			break;
+
+		case InstructionsList::STN:
+			x64.orByte(flags, FLAG_NEGATIVE);
+			break;
+
+		case InstructionsList::STF:
+			x64.orByte(flags, FLAG_INFERIOR);
+			break;
+
+		case InstructionsList::STS:
+			x64.orByte(flags, FLAG_SUPERIOR);
+			break;
+
+		case InstructionsList::STE:
+			x64.orByte(flags, FLAG_EQUAL);
+			break;
+
+		case InstructionsList::STZ:
+			x64.orByte(flags, FLAG_ZERO);
+			break;
+
+		default: // Left to the interpreter
+			supported = false;
+			break;
+		}
+
+		if (!supported)
+			break;
+
+		cycles += instruction.codeLength + INSTRUCTION_OVERHEAD_CYCLES;
+		compiled++;
+		exitAddress = nextAddress;
+
+		if (blockEnd) // The program counter has been set by the final jump
+			x64.exit(cycles, compiled);
+		else if (memoryWrite) // A write into this very block stops it right after the writing instruction
+		{
+			x64.compareAbsoluteByte(&block->valid, 0);
+			size_t stillValid(x64.jump(X64Condition::NOT_ZERO));
+			x64.storeDword(nextAddress, programCounter);
+			x64.exit(cycles, compiled);
+			x64.bind(stillValid);
+		}
+	}
+
+	if (compiled == 0)
+		return;
+
+	if (!blockEnd) // Falls through to the first instruction left to the interpreter, or to the next block
+	{
+		x64.storeDword(exitAddress, programCounter);
+		x64.exit(cycles, compiled);
+	}
+
+	block->code = m_jitBuffer->install(x64.code);
+	block->jitCycles = cycles;
+#endif
+}
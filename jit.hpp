@@ -0,0 +1,28 @@
+#pragma once
+
+#include "defines.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define JIT_AVAILABLE // Native code generation only targets x86-64, other hosts run the blocks engine instead
+#endif
+
+#define JIT_BUFFER_SIZE 8388608 // Executable memory for the compiled blocks, nothing more is compiled once full
+#define JIT_THRESHOLD 16 // Runs of a block before it gets compiled
+
+typedef uint64_t (*JitBlockFunction)(void* cpu); // Returns the cycles spent in the high 32 bits, and the instructions executed in the low 32 bits
+
+// Executable memory holding the compiled blocks, only writable while a block is being installed
+class JitBuffer
+{
+	public:
+		JitBuffer();
+		~JitBuffer();
+
+		void* install(const std::vector<uint8_t>& code); // nullptr if the buffer is full or if no executable memory could be allocated
+
+	private:
+		void setWritable(bool writable);
+
+		uint8_t* m_memory;
+		size_t m_used;
+};
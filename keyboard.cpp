@@ -7,6 +7,12 @@ Keyboard::Keyboard()
 	m_ports.push_back(0x00); // Keycode port
 
 	m_INT = false;
+
+	m_currentKey = { 0x00, false };
+
+	m_receivedKeys = 0;
+	m_droppedKeys = 0;
+	m_highWaterMark = 0;
 }
 
 Keyboard::~Keyboard()
@@ -16,36 +22,73 @@ Keyboard::~Keyboard()
 
 void Keyboard::tick()
 {
-	m_INT = false;
+	clearInterrupt();
 
 	if (m_step == KeyboardStep::CODE) // When a key is pressed, the keyboard sends the key code first
 	{
-		if (m_keyQueue.size() > 0)
+		if (m_keyQueue.pop(m_currentKey))
 		{
-			m_INT = true;
+			triggerInterrupt();
 
-			m_ports[0] = m_keyQueue[0].first;
+			m_ports[0] = m_currentKey.code;
 
 			m_step = KeyboardStep::PRESS_STATE;
 		}
 	}
 	else if (m_step == KeyboardStep::PRESS_STATE) // On the next cycle, the keyboard sends a code to precise if the key was pressed or released
 	{
-		m_INT = true;
+		triggerInterrupt();
 
-		m_ports[0] = m_keyQueue[0].second ? 0x0E : 0x0F; // true = key pressed, custom ascii code 0x0E, false = key released, custom ascii code 0x0F
-		m_keyQueue.erase(m_keyQueue.begin());
+		m_ports[0] = m_currentKey.pressed ? 0x0E : 0x0F; // true = key pressed, custom ascii code 0x0E, false = key released, custom ascii code 0x0F
 
 		m_step = KeyboardStep::CODE;
 	}
 }
 
-void Keyboard::receiveKeyCode(uint8_t k, bool pressed)
+uint64_t Keyboard::getNextEvent()
+{
+	if (m_INT || m_step == KeyboardStep::PRESS_STATE || !m_keyQueue.empty()) // Still sending a key on the next ticks
+		return 0;
+
+	return DEVICE_NO_EVENT; // Waiting for a key hit
+}
+
+bool Keyboard::receiveKeyCode(uint8_t k, bool pressed)
+{
+	m_receivedKeys.fetch_add(1, std::memory_order_relaxed);
+
+	if (!m_keyQueue.push({ k, pressed }))
+	{
+		m_droppedKeys.fetch_add(1, std::memory_order_relaxed);
+
+		return false;
+	}
+
+	unsigned int waitingKeys((unsigned int)m_keyQueue.size());
+
+	if (waitingKeys > m_highWaterMark.load(std::memory_order_relaxed))
+		m_highWaterMark.store(waitingKeys, std::memory_order_relaxed);
+
+	return true;
+}
+
+bool Keyboard::hasPendingKeys()
+{
+	return !m_keyQueue.empty();
+}
+
+// GETTERS
+uint64_t Keyboard::getReceivedKeys()
 {
-	std::pair<uint8_t, bool> keyCode;
+	return m_receivedKeys.load(std::memory_order_relaxed);
+}
 
-	keyCode.first = k;
-	keyCode.second = pressed;
+uint64_t Keyboard::getDroppedKeys()
+{
+	return m_droppedKeys.load(std::memory_order_relaxed);
+}
 
-	m_keyQueue.push_back(keyCode);
+unsigned int Keyboard::getHighWaterMark()
+{
+	return m_highWaterMark.load(std::memory_order_relaxed);
 }
@@ -1,6 +1,15 @@
 #pragma once
 
 #include "device.hpp"
+#include "spscqueue.hpp"
+
+#define KEYBOARD_QUEUE_SIZE 64 // Key hits waiting to be sent, power of two
+
+typedef struct
+{
+	uint8_t code;
+	bool pressed;
+} KeyEvent;
 
 class Keyboard : public Device
 {
@@ -8,13 +17,28 @@ class Keyboard : public Device
 		Keyboard();
 		~Keyboard();
 
+		CACHE_ALIGNED_NEW
+
 		void tick();
 
-		void receiveKeyCode(uint8_t k, bool pressed);
+		bool receiveKeyCode(uint8_t k, bool pressed); // Host input thread side, returns false if the key hit is dropped because the queue is full
+		bool hasPendingKeys(); // Emulation thread side
+
+		uint64_t getNextEvent(); // Ticked on every cycle while sending a key
+
+		// Backpressure statistics
+		uint64_t getReceivedKeys();
+		uint64_t getDroppedKeys();
+		unsigned int getHighWaterMark(); // Most key hits ever waiting at once
 
 	private:
 		enum class KeyboardStep { CODE, PRESS_STATE };
 
 		KeyboardStep m_step;
-		std::vector<std::pair<uint8_t, bool>> m_keyQueue;
+		KeyEvent m_currentKey; // Being sent
+		SPSCQueue<KeyEvent, KEYBOARD_QUEUE_SIZE> m_keyQueue; // Host input thread -> emulation thread, without any lock
+
+		std::atomic<uint64_t> m_receivedKeys; // Only written by the host input thread
+		std::atomic<uint64_t> m_droppedKeys;
+		std::atomic<unsigned int> m_highWaterMark;
 };
@@ -0,0 +1,128 @@
+#include "logger.hpp"
+
+LogEntry Logger::m_entries[LOG_BUFFER_SIZE];
+std::atomic<size_t> Logger::m_head(0);
+size_t Logger::m_tail(0);
+
+std::mutex Logger::m_flushLock;
+std::atomic<bool> Logger::m_running(false);
+std::thread Logger::m_thread;
+std::atomic<uint64_t> Logger::m_droppedMessages(0);
+
+static const char* levelName(uint8_t level)
+{
+	switch (level)
+	{
+	case LOG_LEVEL_DEBUG:
+		return "DEBUG";
+
+	case LOG_LEVEL_INFO:
+		return "INFO";
+
+	case LOG_LEVEL_WARNING:
+		return "WARNING";
+
+	default:
+		return "ERROR";
+	}
+}
+
+void Logger::start()
+{
+	if (m_running.exchange(true))
+		return;
+
+	m_thread = std::thread(drainLoop);
+}
+
+void Logger::stop()
+{
+	if (m_running.exchange(false))
+		m_thread.join();
+
+	flush();
+
+	if (m_droppedMessages > 0)
+		std::cout << "[LOGGER] : " << m_droppedMessages << " messages dropped, the buffer was full" << std::endl;
+}
+
+void Logger::log(uint8_t level, const char* tag, const std::string& message)
+{
+	// Bounded multi-producer queue : each slot holds the first position of the current lap around the buffer while free, and this position + 1 once written
+	size_t position(m_head.load(std::memory_order_relaxed));
+	size_t lap(0);
+	LogEntry* entry(nullptr);
+
+	while (true)
+	{
+		entry = &m_entries[position & (LOG_BUFFER_SIZE - 1)];
+		lap = position & ~(size_t)(LOG_BUFFER_SIZE - 1);
+
+		size_t sequence(entry->sequence.load(std::memory_order_acquire));
+
+		if (sequence == lap)
+		{
+			if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break; // Slot reserved
+
+			// position reloaded by the failed exchange
+		}
+		else if (sequence < lap) // Slot still holding a message from the previous lap
+		{
+			m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		else // Another producer took it first
+			position = m_head.load(std::memory_order_relaxed);
+	}
+
+	size_t length(std::min(message.size(), (size_t)LOG_MESSAGE_SIZE - 1));
+
+	entry->level = level;
+	entry->tag = tag;
+	memcpy(entry->message, message.data(), length);
+	entry->message[length] = '\0';
+
+	entry->sequence.store(lap + 1, std::memory_order_release);
+}
+
+void Logger::flush()
+{
+	std::lock_guard<std::mutex> lock(m_flushLock);
+	bool written(false);
+
+	while (true)
+	{
+		LogEntry* entry(&m_entries[m_tail & (LOG_BUFFER_SIZE - 1)]);
+		size_t lap(m_tail & ~(size_t)(LOG_BUFFER_SIZE - 1));
+
+		if (entry->sequence.load(std::memory_order_acquire) != lap + 1) // Not written yet
+			break;
+
+		std::cout << "[" << entry->tag << "] " << levelName(entry->level) << " : " << entry->message << '\n';
+		written = true;
+
+		entry->sequence.store(lap + LOG_BUFFER_SIZE, std::memory_order_release); // Free for the next lap
+		m_tail++;
+	}
+
+	if (written)
+		std::cout.flush();
+}
+
+// GETTERS
+uint64_t Logger::getDroppedMessages()
+{
+	return m_droppedMessages.load(std::memory_order_relaxed);
+}
+
+// PRIVATE
+void Logger::drainLoop()
+{
+	while (m_running)
+	{
+		flush();
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(LOG_DRAIN_PERIOD));
+	}
+}
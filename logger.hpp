@@ -0,0 +1,61 @@
+#pragma once
+
+#include "defines.hpp"
+
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_WARNING 2
+#define LOG_LEVEL_ERROR 3
+#define LOG_LEVEL_NONE 4
+
+#ifndef LOG_LEVEL // Lowest level compiled in, can be set from the command line (-DLOG_LEVEL=...)
+#ifdef NDEBUG
+#define LOG_LEVEL LOG_LEVEL_INFO
+#else
+#define LOG_LEVEL LOG_LEVEL_DEBUG
+#endif
+#endif
+
+#define LOG_BUFFER_SIZE 1024 // Messages waiting to be written, power of two
+#define LOG_MESSAGE_SIZE 120 // Longer messages are truncated
+#define LOG_DRAIN_PERIOD 20 // Milliseconds between two writes of the background thread
+
+// The message is a stream expression (LOG_DEBUG("IOD", "Data : " << data)), only built if the level is compiled in
+#define LOG(level, tag, message) do { if ((level) >= LOG_LEVEL) { std::ostringstream logStream; logStream << message; Logger::log((level), (tag), logStream.str()); } } while (false)
+#define LOG_DEBUG(tag, message) LOG(LOG_LEVEL_DEBUG, tag, message)
+#define LOG_INFO(tag, message) LOG(LOG_LEVEL_INFO, tag, message)
+#define LOG_WARNING(tag, message) LOG(LOG_LEVEL_WARNING, tag, message)
+#define LOG_ERROR(tag, message) LOG(LOG_LEVEL_ERROR, tag, message)
+
+typedef struct
+{
+	std::atomic<size_t> sequence; // Tells the producers and the consumer whose turn it is on this slot
+	uint8_t level;
+	const char* tag; // String literal
+	char message[LOG_MESSAGE_SIZE];
+} LogEntry;
+
+// Leveled logger : any thread writes its messages in a lock-free buffer, a background thread (or stop()) writes them to the standard output
+class Logger
+{
+	public:
+		static void start(); // Launches the background thread
+		static void stop(); // Joins the background thread and writes the last messages
+
+		static void log(uint8_t level, const char* tag, const std::string& message); // Never blocks, the message is dropped if the buffer is full
+		static void flush(); // Writes the waiting messages, one thread at a time
+
+		static uint64_t getDroppedMessages();
+
+	private:
+		static void drainLoop();
+
+		static LogEntry m_entries[LOG_BUFFER_SIZE];
+		alignas(CACHE_LINE_SIZE) static std::atomic<size_t> m_head; // Next slot to write, shared by the producers
+		alignas(CACHE_LINE_SIZE) static size_t m_tail; // Next slot to read, only used while holding the flush lock
+
+		static std::mutex m_flushLock;
+		static std::atomic<bool> m_running;
+		static std::thread m_thread;
+		static std::atomic<uint64_t> m_droppedMessages;
+};
@@ -0,0 +1,214 @@
+#include "machine.hpp"
+
+Machine::Machine(Engine engine, Display* display)
+{
+	m_engine = engine;
+
+	m_mb = new Motherboard();
+	m_cpu = new CPU(m_mb);
+	m_iod = new IOD(m_mb);
+	m_ram = new RAM(m_mb);
+	m_kb = new Keyboard();
+	m_screen = new Screen(display);
+	m_scheduler = new Scheduler();
+
+	m_mb->plugDevice(m_screen);
+	m_mb->plugDevice(m_kb);
+	m_mb->setScheduler(m_scheduler);
+
+	m_cycles = 0;
+	m_skippedCycles = 0;
+	m_waitingForEvent = false;
+}
+
+Machine::~Machine()
+{
+	m_mb->unplugDevice(m_kb);
+	m_mb->unplugDevice(m_screen);
+
+	delete m_kb;
+	delete m_screen;
+	delete m_iod;
+	delete m_cpu; // Before the RAM chip, the CPU caches are listening to its writes
+	delete m_ram;
+	delete m_mb;
+	delete m_scheduler;
+}
+
+uint64_t Machine::run(uint64_t cycles)
+{
+	switch (m_engine)
+	{
+	case Engine::INTERPRETER:
+		return runEngine<Engine::INTERPRETER>(cycles, nullptr);
+
+	case Engine::BLOCKS:
+		return runEngine<Engine::BLOCKS>(cycles, nullptr);
+
+	case Engine::JIT:
+		return runEngine<Engine::JIT>(cycles, nullptr);
+
+	default:
+		return runEngine<Engine::MICROCODE>(cycles, nullptr);
+	}
+}
+
+uint64_t Machine::runUntil(const std::function<bool()>& predicate, uint64_t maxCycles)
+{
+	if (maxCycles == 0)
+		maxCycles = UINT64_MAX;
+
+	switch (m_engine)
+	{
+	case Engine::INTERPRETER:
+		return runEngine<Engine::INTERPRETER>(maxCycles, &predicate);
+
+	case Engine::BLOCKS:
+		return runEngine<Engine::BLOCKS>(maxCycles, &predicate);
+
+	case Engine::JIT:
+		return runEngine<Engine::JIT>(maxCycles, &predicate);
+
+	default:
+		return runEngine<Engine::MICROCODE>(maxCycles, &predicate);
+	}
+}
+
+bool Machine::pressKey(uint8_t keyCode, bool pressed)
+{
+	return m_kb->receiveKeyCode(keyCode, pressed); // The keyboard is scheduled by the emulation thread, at the start of the next batch
+}
+
+// GETTERS
+Engine Machine::getEngine()
+{
+	return m_engine;
+}
+
+uint64_t Machine::getCycles()
+{
+	return m_cycles;
+}
+
+uint64_t Machine::getSkippedCycles()
+{
+	return m_skippedCycles;
+}
+
+bool Machine::isWaitingForEvent()
+{
+	return m_waitingForEvent;
+}
+
+Motherboard* Machine::getMotherboard()
+{
+	return m_mb;
+}
+
+CPU* Machine::getCPU()
+{
+	return m_cpu;
+}
+
+IOD* Machine::getIOD()
+{
+	return m_iod;
+}
+
+RAM* Machine::getRAM()
+{
+	return m_ram;
+}
+
+Keyboard* Machine::getKeyboard()
+{
+	return m_kb;
+}
+
+Screen* Machine::getScreen()
+{
+	return m_screen;
+}
+
+Scheduler* Machine::getScheduler()
+{
+	return m_scheduler;
+}
+
+// PRIVATE
+template <Engine engine>
+uint64_t Machine::runEngine(uint64_t cycles, const std::function<bool()>* predicate)
+{
+	uint64_t ranCycles(0), stepCycles(0), skippableCycles(0);
+
+	m_waitingForEvent = false;
+
+	if (m_kb->hasPendingKeys()) // Key hits received from the host since the last batch
+		m_scheduler->schedule(m_kb, m_cycles);
+
+	while (ranCycles < cycles && (predicate == nullptr || !(*predicate)()))
+	{
+		stepCycles = step<engine>(cycles - ranCycles);
+		ranCycles += stepCycles;
+		m_cycles += stepCycles;
+
+		if (!m_cpu->isHalted())
+			continue;
+
+		skippableCycles = idleCycles();
+
+		if (skippableCycles == DEVICE_NO_EVENT) // Nothing left to run until the host sends something
+		{
+			m_waitingForEvent = true;
+			m_screen->presentIfDue(true); // The last frame asked could wait forever otherwise
+			break;
+		}
+
+		skippableCycles = std::min(skippableCycles, cycles - std::min(ranCycles, cycles)); // Jumping to the next device event
+		ranCycles += skippableCycles;
+		m_cycles += skippableCycles;
+		m_skippedCycles += skippableCycles;
+	}
+
+	m_screen->presentIfDue(); // Frame held back by the frame rate limit
+
+	return ranCycles;
+}
+
+template <Engine engine>
+unsigned int Machine::step(uint64_t maxCycles)
+{
+	unsigned int cycles(1);
+
+	m_scheduler->setCycle(m_cycles); // The port writes of this step wake their device up before the end of the step
+
+	if (engine == Engine::INTERPRETER)
+		cycles = m_cpu->step(); // Reads and writes the RAM chip directly, no RAM tick needed
+	else if (engine == Engine::BLOCKS || engine == Engine::JIT)
+		cycles = m_cpu->runBlocks((unsigned int)std::min<uint64_t>(maxCycles, BLOCK_CHAIN_MAX_CYCLES), engine == Engine::JIT);
+	else
+		m_cpu->tick();
+
+	if (!m_iod->isIdle()) // Nothing raised, queued nor accessed
+		m_iod->tick();
+
+	if (engine == Engine::MICROCODE)
+		m_ram->tick();
+
+	m_scheduler->runDueDevices();
+
+	return cycles;
+}
+
+uint64_t Machine::idleCycles()
+{
+	if (!m_cpu->isHalted() || !m_cpu->isAtInstructionBoundary() || !m_iod->isIdle()) // The code engine ends the HLT instruction on the next tick
+		return 0;
+
+	uint64_t nextEvent(m_scheduler->getNextEvent());
+
+	if (nextEvent == DEVICE_NO_EVENT)
+		return DEVICE_NO_EVENT;
+
+	return (nextEvent > m_cycles) ? nextEvent - m_cycles : 0;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "cpu.hpp"
+#include "iod.hpp"
+#include "ram.hpp"
+#include "keyboard.hpp"
+#include "screen.hpp"
+#include "scheduler.hpp"
+
+// The whole computer : owns its chips and devices, and runs them by batches of cycles
+class Machine
+{
+	public:
+		Machine(Engine engine, Display* display); // The screen takes ownership of the display
+		~Machine();
+
+		uint64_t run(uint64_t cycles); // Returns the cycles actually run, more if the last step goes over, less if the computer ends up waiting for a host event
+		uint64_t runUntil(const std::function<bool()>& predicate, uint64_t maxCycles = 0); // The predicate is checked before each step, 0 = no limit
+
+		bool pressKey(uint8_t keyCode, bool pressed); // Host key hit for the emulated keyboard, callable from the host input thread, false if the keyboard queue is full
+
+		// Getters
+		Engine getEngine();
+		uint64_t getCycles(); // Since power on
+		uint64_t getSkippedCycles(); // Part of the cycles fast-forwarded while the CPU was halted, without emulating them
+		bool isWaitingForEvent(); // Halted with no interrupt to come from the devices, only a host event can wake the CPU up
+		Motherboard* getMotherboard();
+		CPU* getCPU();
+		IOD* getIOD();
+		RAM* getRAM();
+		Keyboard* getKeyboard();
+		Screen* getScreen();
+		Scheduler* getScheduler();
+
+	private:
+		template <Engine engine>
+		uint64_t runEngine(uint64_t cycles, const std::function<bool()>* predicate); // The engine is chosen once per batch, not on each step
+
+		template <Engine engine>
+		unsigned int step(uint64_t maxCycles); // One cycle, one instruction or one chain of blocks, and the ticks of the devices due
+
+		uint64_t idleCycles(); // Cycles that can be skipped without changing anything, 0 if the CPU isn't waiting for an interrupt
+
+		Engine m_engine;
+
+		Motherboard* m_mb;
+		CPU* m_cpu;
+		IOD* m_iod;
+		RAM* m_ram;
+		Keyboard* m_kb;
+		Screen* m_screen;
+		Scheduler* m_scheduler;
+
+		uint64_t m_cycles;
+		uint64_t m_skippedCycles;
+		bool m_waitingForEvent;
+};
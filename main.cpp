@@ -1,8 +1,19 @@
-#include "cpu.hpp"
-#include "iod.hpp"
-#include "ram.hpp"
-#include "screen.hpp"
-
+#include "machine.hpp"
+#include "sfmldisplay.hpp"
+#include "spscqueue.hpp"
+#include "benchmark.hpp"
+#include "logger.hpp"
+#include "image.hpp"
+#include "softwaredisplay.hpp"
+
+#include <cstdlib>
+#include <cerrno>
+
+#define EMULATION_BATCH_CYCLES 16384 // Cycles run between two checks of the host events queue and of the key hits
+#define HEADLESS_BATCH_CYCLES 0x100000 // Cycles run between two reads of the host clock
+#define HOST_EVENTS_QUEUE_SIZE 256
+
+#ifndef HEADLESS
 typedef struct
 {
 	sf::Text addressBusTxt;
@@ -29,26 +40,210 @@ typedef struct
 	sf::Text frequency;
 } TextStruct;
 
+enum class HostEventType { STEP, STEP_MODE }; // The key hits go straight to the keyboard queue
+
+typedef struct
+{
+	HostEventType type;
+} HostEvent;
+
+typedef struct
+{
+	SPSCQueue<HostEvent, HOST_EVENTS_QUEUE_SIZE> events; // Window thread -> emulation thread
+	std::mutex computerLock; // Held by the emulation thread while it runs a batch of cycles
+	std::mutex wakeLock;
+	std::condition_variable wakeUp; // The emulation thread sleeps on it while the computer waits for a key hit
+
+	std::atomic<bool> running;
+	std::atomic<bool> stepByStepMode;
+	std::atomic<bool> clockState; // Low = false | High = true
+	std::atomic<uint64_t> clockCycles;
+
+	CACHE_ALIGNED_NEW // The events queue is cache line aligned
+} EmulationContext;
+
+void runDiagram(Machine* computer, Display* display);
+void emulationLoop(EmulationContext* ctx, Machine* computer);
+bool pushHostEvent(EmulationContext* ctx, const HostEvent& hostEvt);
+void wakeEmulation(EmulationContext* ctx);
 void initTexts(sf::Font* font, TextStruct* texts);
 void updateTexts(TextStruct* texts, Motherboard* mb, CPU* cpuChip, IOD* iodChip, bool stepMode, int freq);
-void computerTick(CPU* cpuChip, IOD* iodChip, RAM* ramChip, Screen* monitor, Keyboard* kb);
 void drawTexts(TextStruct* texts, sf::RenderWindow* window);
 void drawCPUState(Step cpuState, sf::RectangleShape* redInd1, sf::RectangleShape* redInd2, sf::RectangleShape* redInd3, sf::RectangleShape* redInd4,
 				  sf::RectangleShape* redInd5, sf::RectangleShape* orgInd, sf::RectangleShape* grnInd, sf::RenderWindow* window);
+#endif
+void runHeadless(Machine* computer, uint64_t cyclesToRun);
 
-int main()
+int main(int argc, char* argv[])
 {
+	// Command line
+	bool headless(false); // No window at all, the computer runs at full host speed
+	bool benchmark(false);
+	bool verify(false); // Lockstep comparison of the selected engine with the code engine
+	Engine engine(Engine::MICROCODE);
+	uint64_t cyclesToRun(0); // 0 = no limit
+	std::string imagePath; // Empty = demo program
+	uint32_t loadAddress(WORK_MEMORY_START_ADDRESS); // Of a flat binary image
+	std::string capturePrefix; // Empty = the monitor isn't rendered in headless mode
+	bool captureAllFrames(false);
+	bool vram(false); // Text VRAM window mapped at VRAM_START_ADDRESS
+
+	for (int i(1); i < argc; i++)
+	{
+		std::string arg(argv[i]);
+
+		if (arg == "--headless")
+			headless = true;
+		else if (arg == "--bench")
+			benchmark = true;
+		else if (arg == "--verify")
+			verify = true;
+		else if (arg == "--cycles" && i + 1 < argc)
+		{
+			char* end(nullptr);
+
+			errno = 0;
+			cyclesToRun = std::strtoull(argv[++i], &end, 10);
+
+			if (end == argv[i] || *end != '\0' || errno == ERANGE || argv[i][0] == '-')
+			{
+				std::cout << "Invalid cycle count \"" << argv[i] << "\", expected --cycles <decimal number>" << std::endl;
+				return 1;
+			}
+		}
+		else if (arg == "--image" && i + 1 < argc)
+			imagePath = argv[++i];
+		else if (arg == "--load-address" && i + 1 < argc)
+		{
+			char* end(nullptr);
+
+			errno = 0;
+			unsigned long long address(std::strtoull(argv[++i], &end, 16));
+
+			if (end == argv[i] || *end != '\0' || errno == ERANGE || argv[i][0] == '-' || address > WORK_MEMORY_END_ADDRESS)
+			{
+				std::cout << "Invalid load address \"" << argv[i] << "\", expected --load-address <hexadecimal address up to FFFFFF>" << std::endl;
+				return 1;
+			}
+
+			loadAddress = (uint32_t)address;
+		}
+		else if (arg == "--capture" && i + 1 < argc) // Software rendered monitor, the last frame is saved as <prefix>.ppm and <prefix>.txt
+		{
+			capturePrefix = argv[++i];
+			headless = true;
+		}
+		else if (arg == "--capture-all-frames")
+			captureAllFrames = true;
+		else if (arg == "--vram")
+			vram = true;
+		else if (arg == "--engine" && i + 1 < argc)
+		{
+			std::string engineName(argv[++i]);
+
+			if (engineName == "interpreter")
+				engine = Engine::INTERPRETER;
+			else if (engineName == "blocks")
+				engine = Engine::BLOCKS;
+			else if (engineName == "jit")
+				engine = Engine::JIT;
+			else if (engineName == "microcode")
+				engine = Engine::MICROCODE;
+			else
+			{
+				std::cout << "Unknown engine \"" << engineName << "\", expected --engine <microcode | interpreter | blocks | jit>" << std::endl;
+				return 1;
+			}
+		}
+	}
+
+#ifndef JIT_AVAILABLE
+	if (engine == Engine::JIT)
+	{
+		std::cout << "The JIT engine isn't available on this host, using the blocks engine" << std::endl;
+		engine = Engine::BLOCKS;
+	}
+#endif
+
+	Logger::start(); // The emulation threads never write to the standard output themselves
+
+	if (verify)
+	{
+		bool identical(runVerification((cyclesToRun != 0) ? cyclesToRun : BENCHMARK_DEFAULT_CYCLES, engine));
+
+		Logger::stop();
+
+		return identical ? 0 : 1;
+	}
+
+	if (benchmark)
+	{
+		runBenchmark((cyclesToRun != 0) ? cyclesToRun : BENCHMARK_DEFAULT_CYCLES, engine);
+		Logger::stop();
+
+		return 0;
+	}
+
+	SoftwareDisplay* capture(capturePrefix.empty() ? nullptr : new SoftwareDisplay());
+
+	if (capture != nullptr && captureAllFrames)
+		capture->setFramesCapture(capturePrefix);
+
+#ifdef HEADLESS
+	headless = true; // Nothing else available in this build
+	Display* display = (capture != nullptr) ? (Display*)capture : (Display*)new NullDisplay();
+#else
+	Display* display = (capture != nullptr) ? (Display*)capture : headless ? (Display*)new NullDisplay() : (Display*)new SFMLDisplay();
+#endif
+
 	// Computer init
-	Motherboard* mb = new Motherboard();
-	CPU* cpuChip = new CPU(mb);
-	IOD* iodChip = new IOD(mb);
-	RAM* ramChip = new RAM(mb);
-	Keyboard* kb = new Keyboard();
-	Screen* monitor = new Screen(kb);
+	Machine* computer = new Machine(engine, display);
+
+	if (vram)
+		computer->getScreen()->mapVRAM(computer->getRAM()); // Before loading the program, so an image can fill the VRAM
+
+	if (capture != nullptr)
+		computer->getScreen()->setMaxFPS(0); // A frame per refresh from the guest, so the captures don't depend on the host speed
+
+	if (imagePath.empty())
+		computer->getRAM()->loadDemoProgram();
+	else if (!loadProgramImage(computer->getRAM(), imagePath, loadAddress))
+	{
+		delete computer;
+		Logger::stop();
+
+		return 1;
+	}
+
+	if (headless)
+	{
+		runHeadless(computer, cyclesToRun);
+
+		if (capture != nullptr)
+		{
+			if (!capture->saveFrame(capturePrefix + ".ppm"))
+				std::cout << "[HEADLESS] : Unable to save the monitor capture as \"" << capturePrefix << ".ppm\"" << std::endl;
 
-	mb->plugDevice(monitor);
-	mb->plugDevice(kb);
+			if (!capture->saveCharacterGrid(capturePrefix + ".txt"))
+				std::cout << "[HEADLESS] : Unable to save the monitor characters as \"" << capturePrefix << ".txt\"" << std::endl;
+		}
+	}
+#ifndef HEADLESS
+	else
+		runDiagram(computer, display);
+#endif
 
+	// Memory clearance
+	delete computer;
+
+	Logger::stop();
+
+    return 0;
+}
+
+#ifndef HEADLESS
+void runDiagram(Machine* computer, Display* display)
+{
 	// Window init
 	sf::RenderWindow* window = new sf::RenderWindow(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "HBC-2 Emulator - CPU Diagram", sf::Style::Titlebar | sf::Style::Close);
 	sf::Event* evt = new sf::Event();
@@ -123,16 +318,26 @@ int main()
 	orangeIndicator->setPosition(ORANGE_POS_X, ORANGE_POS_Y);
 	greenIndicator->setPosition(GREEN_POS_X, GREEN_POS_Y);
 
+	// Emulation thread
+	EmulationContext* ctx = new EmulationContext();
+	HostEvent hostEvt = { HostEventType::STEP };
+	uint8_t keyCode(0);
+	bool pressed(false);
+
+	ctx->running = true;
+	ctx->stepByStepMode = true;
+	ctx->clockState = false;
+	ctx->clockCycles = 0;
+
+	std::thread emulation(emulationLoop, ctx, computer);
+
 	// Clock
-	bool stepByStepMode(true);
-	bool clockState(false); // Low = false | High = true
-	bool tick(true); // True if the user asks to go one step forward (T key)
 	int currentFrequency(0); // In kHz
-	sf::Time currentTime, previousTime, lastFreqMeasure;
+	uint64_t lastClockCycles(0);
+	sf::Time currentTime, lastFreqMeasure;
 	sf::Clock clock;
-	int clockCycles(0);
 
-	// === Event loop ===
+	// === Event loop (runs at the display rate, the computer itself runs in the emulation thread) ===
 	while (window->isOpen())
 	{
 		while (window->pollEvent(*evt))
@@ -145,64 +350,66 @@ int main()
 					window->close();
 				else if (evt->key.code == sf::Keyboard::T) // Step by step command (usable only in step by step mode)
 				{
-					if (stepByStepMode)
-					{
-						tick = true;
-					}
+					hostEvt.type = HostEventType::STEP;
+					pushHostEvent(ctx, hostEvt);
 				}
 				else if (evt->key.code == sf::Keyboard::S) // Step by step mode command
 				{
-					stepByStepMode = !stepByStepMode;
-
-					if (!stepByStepMode)
-						tick = true;
+					hostEvt.type = HostEventType::STEP_MODE;
+					pushHostEvent(ctx, hostEvt);
 				}
 			}
 		}
 
-		// Computer update
-		if (tick)
+		if (display->pollKeyEvent(keyCode, pressed)) // Key hits on the monitor window are meant for the emulated keyboard, without waiting for the emulation thread
 		{
-			clockState = !clockState;
-
-			computerTick(cpuChip, iodChip, ramChip, monitor, kb);
-			clockCycles++;
+			do
+			{
+				if (!computer->pressKey(keyCode, pressed))
+					break; // Keyboard queue full, this key hit is dropped and the remaining ones wait for the next frame
+			} while (display->pollKeyEvent(keyCode, pressed));
 
-			if (stepByStepMode)
-				tick = false;
+			wakeEmulation(ctx);
 		}
 
-		// Window update (60 FPS)
+		// Calculating average frequency during last second
 		currentTime = clock.getElapsedTime();
-		if (currentTime.asMilliseconds() - previousTime.asMilliseconds() >= (1000.f / FPS))
+		if (currentTime.asMilliseconds() - lastFreqMeasure.asMilliseconds() >= 1000.f) // Measuring every second
 		{
-			// Calculating average frequency during last second
-			if (currentTime.asMilliseconds() - lastFreqMeasure.asMilliseconds() >= 1000.f) // Measuring every second
-			{
-				currentFrequency = (int)((float)clockCycles / 1000.f);
+			currentFrequency = (int)((float)(ctx->clockCycles - lastClockCycles) / 1000.f);
 
-				clockCycles = 0;
-				lastFreqMeasure = clock.getElapsedTime();
-			}
+			lastClockCycles = ctx->clockCycles;
+			lastFreqMeasure = currentTime;
+		}
+
+		// Window update
+		{
+			std::lock_guard<std::mutex> lock(ctx->computerLock); // Waits for the current batch, so the diagram shows a consistent state
 
-			updateTexts(texts, mb, cpuChip, iodChip, stepByStepMode, currentFrequency);
+			updateTexts(texts, computer->getMotherboard(), computer->getCPU(), computer->getIOD(), ctx->stepByStepMode, currentFrequency);
 
 			window->clear();
 
 			window->draw(*background);
-			window->draw((clockState) ? *clockHigh : *clockLow); // I love ternary conditions
-			drawCPUState(cpuChip->getCurrentStep(), redIndicator1, redIndicator2, redIndicator3, redIndicator4, redIndicator5, orangeIndicator, greenIndicator, window);
+			window->draw((ctx->clockState) ? *clockHigh : *clockLow); // I love ternary conditions
+			drawCPUState(computer->getCPU()->getCurrentStep(), redIndicator1, redIndicator2, redIndicator3, redIndicator4, redIndicator5, orangeIndicator, greenIndicator, window);
 			drawTexts(texts, window);
+		}
 
-			window->display();
+		window->display();
 
-			currentTime = previousTime = clock.getElapsedTime();
-		}
-    }
+		sf::sleep(sf::milliseconds((sf::Int32)(1000.f / FPS)));
+	}
+
+	ctx->running = false;
+	wakeEmulation(ctx);
+	emulation.join();
+
+	std::cout << "[KEYBOARD] : " << computer->getKeyboard()->getReceivedKeys() << " key hits | " << computer->getKeyboard()->getDroppedKeys() << " dropped | high-water mark "
+			  << computer->getKeyboard()->getHighWaterMark() << " / " << KEYBOARD_QUEUE_SIZE << std::endl;
+	std::cout << "[SCREEN] : " << computer->getScreen()->getPresentedFrames() << " frames presented | " << computer->getScreen()->getCoalescedRefreshes() << " refreshes coalesced | "
+			  << computer->getScreen()->getSkippedRefreshes() << " refreshes skipped" << std::endl;
 
-	mb->unplugDevice(kb);
-	mb->unplugDevice(monitor);
-	
 	// Memory clearance
 	delete redIndicator1;     delete redIndicator2;     delete redIndicator3;     delete redIndicator4;     delete redIndicator5;
 	delete orangeIndicator;   delete greenIndicator;
@@ -217,16 +424,76 @@ int main()
 	delete texts;
 	delete font;
 
+	delete ctx;
 	delete evt;
 	delete window;
+}
+
+void emulationLoop(EmulationContext* ctx, Machine* computer)
+{
+	HostEvent hostEvt = { HostEventType::STEP };
+	bool tick(true); // True if the user asks to go one step forward (T key)
 
-	delete monitor;
-	delete ramChip;
-	delete iodChip;
-	delete cpuChip;
-	delete mb;
+	while (ctx->running)
+	{
+		while (ctx->events.pop(hostEvt))
+		{
+			switch (hostEvt.type)
+			{
+				case HostEventType::STEP:
+					if (ctx->stepByStepMode)
+						tick = true;
+					break;
 
-    return 0;
+				case HostEventType::STEP_MODE:
+					ctx->stepByStepMode = !ctx->stepByStepMode;
+
+					if (!ctx->stepByStepMode)
+						tick = true;
+					break;
+			}
+		}
+
+		if (!tick) // Step by step mode, nothing to do until the user asks for the next step
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(ctx->computerLock);
+
+			ctx->clockCycles += computer->run(ctx->stepByStepMode ? 1 : EMULATION_BATCH_CYCLES); // One step is a whole instruction with the interpreter
+			ctx->clockState = !ctx->clockState;
+		}
+
+		if (ctx->stepByStepMode) // Halted cycles are still shown one by one in step by step mode
+			tick = false;
+		else if (computer->isWaitingForEvent()) // Halted until a key hit, sleeping instead of ticking for nothing
+		{
+			std::unique_lock<std::mutex> lock(ctx->wakeLock);
+
+			ctx->wakeUp.wait(lock, [ctx, computer] { return !ctx->events.empty() || computer->getKeyboard()->hasPendingKeys() || !ctx->running; });
+		}
+	}
+}
+
+bool pushHostEvent(EmulationContext* ctx, const HostEvent& hostEvt) // Returns false if the queue is full
+{
+	bool pushed(ctx->events.push(hostEvt));
+
+	wakeEmulation(ctx);
+
+	return pushed;
+}
+
+void wakeEmulation(EmulationContext* ctx) // If it is waiting for a key hit
+{
+	{
+		std::lock_guard<std::mutex> lock(ctx->wakeLock); // So the emulation thread can't miss the notification between its check and its wait
+	}
+
+	ctx->wakeUp.notify_one();
 }
 
 void initTexts(sf::Font* font, TextStruct* texts)
@@ -370,15 +637,54 @@ void updateTexts(TextStruct* texts, Motherboard* mb, CPU* cpuChip, IOD* iodChip,
 	texts->frequency.setString(frequencyStr);
 }
 
-void computerTick(CPU* cpuChip, IOD* iodChip, RAM* ramChip, Screen* monitor, Keyboard* kb)
+#endif
+
+void runHeadless(Machine* computer, uint64_t cyclesToRun)
 {
-	cpuChip->tick();
-	iodChip->tick();
-	ramChip->tick();
-	monitor->tick();
-	kb->tick();
+	std::chrono::steady_clock::time_point start(std::chrono::steady_clock::now());
+	std::chrono::steady_clock::time_point lastFreqMeasure(start), currentTime(start);
+	uint64_t clockCycles(0), lastClockCycles(0), emulatedCycles(0); // Emulated = without the cycles skipped while the CPU was halted
+	double elapsed(0.0);
+
+	while (cyclesToRun == 0 || clockCycles < cyclesToRun)
+	{
+		clockCycles += computer->run((cyclesToRun != 0) ? std::min<uint64_t>(cyclesToRun - clockCycles, HEADLESS_BATCH_CYCLES) : HEADLESS_BATCH_CYCLES);
+
+		if (computer->isWaitingForEvent()) // Nothing can wake the CPU up without a keyboard
+		{
+			std::cout << "[HEADLESS] : CPU halted with no interrupt to come" << std::endl;
+			break;
+		}
+
+		currentTime = std::chrono::steady_clock::now();
+		elapsed = std::chrono::duration<double>(currentTime - lastFreqMeasure).count();
+
+		if (elapsed >= 1.0) // Measuring every second
+		{
+			emulatedCycles = clockCycles - computer->getSkippedCycles();
+
+			std::cout << "[HEADLESS] : Frequency : " << (int)((double)(emulatedCycles - lastClockCycles) / elapsed / 1000.0) << " kHz" << std::endl;
+
+			lastClockCycles = emulatedCycles;
+			lastFreqMeasure = currentTime;
+		}
+	}
+
+	elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	emulatedCycles = clockCycles - computer->getSkippedCycles();
+
+	std::cout << "[HEADLESS] : " << emulatedCycles << " cycles in " << elapsed << " s (average frequency : " << (int)((double)emulatedCycles / elapsed / 1000.0) << " kHz)" << std::endl;
+
+	if (computer->getSkippedCycles() > 0)
+		std::cout << "[HEADLESS] : " << computer->getSkippedCycles() << " idle cycles skipped while the CPU was halted" << std::endl;
+	std::cout << "[HEADLESS] : " << computer->getCPU()->getInstructionsCount() << " instructions executed (" << (int)((double)computer->getCPU()->getInstructionsCount() / elapsed / 1000.0) << " thousand instructions per second)" << std::endl;
+	std::cout << "[HEADLESS] : Interrupts : " << computer->getIOD()->getEnqueuedInterrupts() << " enqueued | " << computer->getIOD()->getDeliveredInterrupts() << " delivered | "
+			  << computer->getIOD()->getDroppedInterrupts() << " dropped | high-water mark " << computer->getIOD()->getHighWaterMark() << " / " << INTERRUPT_QUEUE_SIZE << std::endl;
+	std::cout << "[HEADLESS] : Screen : " << computer->getScreen()->getPresentedFrames() << " frames presented | " << computer->getScreen()->getCoalescedRefreshes() << " refreshes coalesced | "
+			  << computer->getScreen()->getSkippedRefreshes() << " refreshes skipped" << std::endl;
 }
 
+#ifndef HEADLESS
 void drawTexts(TextStruct* texts, sf::RenderWindow* window)
 {
 	window->draw(texts->addressBusTxt);
@@ -460,3 +766,4 @@ void drawCPUState(Step cpuState, sf::RectangleShape* redInd1, sf::RectangleShape
 			break;
 	}
 }
+#endif
@@ -0,0 +1,858 @@
+#include "microcode.hpp"
+
+#define OP0(op) { opcodesList::op, { operandsList::R1, operandsList::R1 } } // Unused operands are never read
+#define OP1(op, a) { opcodesList::op, { operandsList::a, operandsList::R1 } }
+#define OP2(op, a, b) { opcodesList::op, { operandsList::a, operandsList::b } }
+
+#define SEQUENCE(instruction, addressingMode, code) { InstructionsList::instruction, AddressingModesList::addressingMode, code, sizeof(code) / sizeof(Instruction) }
+
+typedef struct
+{
+	InstructionsList instruction;
+	AddressingModesList addressingMode;
+	const Instruction* code;
+	uint16_t length;
+} codeSequence;
+
+// === ADC ===
+// -- Reg --
+static constexpr Instruction ADC_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, R2), OP0(ADC), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction ADC_REG_IMM8[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, V1), OP0(ADC), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction ADC_REG_RAM[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC2, DATABUS),
+	OP0(ADC), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === ADD ===
+// -- Reg --
+static constexpr Instruction ADD_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, R2), OP0(ADD), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction ADD_REG_IMM8[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, V1), OP0(ADD), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction ADD_REG_RAM[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC2, DATABUS),
+	OP0(ADD), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === AND ===
+// -- Reg --
+static constexpr Instruction AND_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, R2), OP0(AND), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction AND_REG_IMM8[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, V1), OP0(AND), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction AND_REG_RAM[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC2, DATABUS),
+	OP0(AND), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === CAL ===
+// -- Reg24 --
+static constexpr Instruction CAL_REG24[] =
+{
+	OP1(MOVADDBUS, STK), OP1(MOVDATABUS, PC8), OP0(RAMWRITE), OP0(INCSTK),
+	OP1(MOVADDBUS, STK), OP1(MOVDATABUS, PC_8), OP0(RAMWRITE), OP0(INCSTK),
+	OP1(MOVADDBUS, STK), OP1(MOVDATABUS, PC_16), OP0(RAMWRITE), OP0(INCSTK),
+	OP1(MOVPC, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction CAL_IMM24[] =
+{
+	OP1(MOVADDBUS, STK), OP1(MOVDATABUS, PC8), OP0(RAMWRITE), OP0(INCSTK),
+	OP1(MOVADDBUS, STK), OP1(MOVDATABUS, PC_8), OP0(RAMWRITE), OP0(INCSTK),
+	OP1(MOVADDBUS, STK), OP1(MOVDATABUS, PC_16), OP0(RAMWRITE), OP0(INCSTK),
+	OP1(MOVPC, VX)
+};
+
+// === CLC ===
+// -- None --
+static constexpr Instruction CLC_NONE[] =
+{
+	OP0(CLC)
+};
+
+// === CLE ===
+// -- None --
+static constexpr Instruction CLE_NONE[] =
+{
+	OP0(CLE)
+};
+
+// === CLI ===
+// -- None --
+static constexpr Instruction CLI_NONE[] =
+{
+	OP0(CLI)
+};
+
+// === CLN ===
+// -- None --
+static constexpr Instruction CLN_NONE[] =
+{
+	OP0(CLN)
+};
+
+// === CLS ===
+// -- None --
+static constexpr Instruction CLS_NONE[] =
+{
+	OP0(CLS)
+};
+
+// === CLZ ===
+// -- None --
+static constexpr Instruction CLZ_NONE[] =
+{
+	OP0(CLZ)
+};
+
+// === CLF ===
+// -- None --
+static constexpr Instruction CLF_NONE[] =
+{
+	OP0(CLF)
+};
+
+// === CMP ===
+// -- Reg --
+static constexpr Instruction CMP_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, R2), OP0(CMP)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction CMP_REG_IMM8[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, V1), OP0(CMP)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction CMP_REG_RAM[] =
+{
+	OP1(MOVADDBUS, RX), OP0(RAMREAD), OP1(MOVACC2, DATABUS), OP1(MOVACC1, R4),
+	OP0(CMP)
+};
+
+// === DEC ===
+// -- Reg --
+static constexpr Instruction DEC_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, X1), OP0(SUB), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg24 --
+static constexpr Instruction DEC_REG24[] =
+{
+	OP1(MOVADDBUS, RX), OP0(RAMREAD), OP1(MOVACC1, DATABUS), OP1(MOVACC2, X1),
+	OP0(SUB), OP1(MOVADDBUS, RX), OP1(MOVDATABUS, ALUOUT), OP0(RAMWRITE)
+};
+
+// -- Imm24 --
+static constexpr Instruction DEC_IMM24[] =
+{
+	OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC1, DATABUS), OP1(MOVACC2, X1),
+	OP0(SUB), OP1(MOVADDBUS, VX), OP1(MOVDATABUS, ALUOUT), OP0(RAMWRITE)
+};
+
+// === HLT ===
+// -- None --
+static constexpr Instruction HLT_NONE[] =
+{
+	OP0(STH)
+};
+
+// === IN ===
+// -- Reg --
+static constexpr Instruction IN_REG[] =
+{
+	OP1(MOVADDBUS, R2), OP0(IN), OP2(MOVREG, R1, DATABUS)
+};
+
+// === OUT ===
+// -- Reg --
+static constexpr Instruction OUT_REG[] =
+{
+	OP1(MOVDATABUS, R2), OP1(MOVADDBUS, R1), OP0(OUT)
+};
+
+// === INC ===
+// -- Reg --
+static constexpr Instruction INC_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, X1), OP0(ADD), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg24 --
+static constexpr Instruction INC_REG24[] =
+{
+	OP1(MOVADDBUS, RX), OP0(RAMREAD), OP1(MOVACC1, DATABUS), OP1(MOVACC2, X1),
+	OP0(ADD), OP1(MOVADDBUS, RX), OP1(MOVDATABUS, ALUOUT), OP0(RAMWRITE)
+};
+
+// -- Imm24 --
+static constexpr Instruction INC_IMM24[] =
+{
+	OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC1, DATABUS), OP1(MOVACC2, X1),
+	OP0(ADD), OP1(MOVADDBUS, VX), OP1(MOVDATABUS, ALUOUT), OP0(RAMWRITE)
+};
+
+// === INT ===
+// -- Imm8 --
+static constexpr Instruction INT_IMM8[] =
+{
+	OP1(MOVADDBUS, V1), OP0(INT)
+};
+
+// === IRT ===
+// -- None --
+static constexpr Instruction IRT_NONE[] =
+{
+	OP0(STI), OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD),
+	OP2(MOVREG, I, DATABUS), OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD),
+	OP1(MOVPC, DATABUS16), OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD),
+	OP1(MOVPC, PCDATABUS8), OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD),
+	OP1(MOVPC, PCDATABUS)
+};
+
+// === JMC ===
+// -- Reg24 --
+static constexpr Instruction JMC_REG24[] =
+{
+	OP1(JMC, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JMC_IMM24[] =
+{
+	OP1(JMC, VX)
+};
+
+// === JME ===
+// -- Reg24 --
+static constexpr Instruction JME_REG24[] =
+{
+	OP1(JME, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JME_IMM24[] =
+{
+	OP1(JME, VX)
+};
+
+// === JMF ===
+// -- Reg24 --
+static constexpr Instruction JMF_REG24[] =
+{
+	OP1(JMF, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JMF_IMM24[] =
+{
+	OP1(JMF, VX)
+};
+
+// === JMK ===
+// -- Reg24 --
+static constexpr Instruction JMK_REG24[] =
+{
+	OP1(JMK, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JMK_IMM24[] =
+{
+	OP1(JMK, VX)
+};
+
+// === JMP ===
+// -- Reg24 --
+static constexpr Instruction JMP_REG24[] =
+{
+	OP1(JMP, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JMP_IMM24[] =
+{
+	OP1(JMP, VX)
+};
+
+// === JMS ===
+// -- Reg24 --
+static constexpr Instruction JMS_REG24[] =
+{
+	OP1(JMS, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JMS_IMM24[] =
+{
+	OP1(JMS, VX)
+};
+
+// === JMZ ===
+// -- Reg24 --
+static constexpr Instruction JMZ_REG24[] =
+{
+	OP1(JMZ, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JMZ_IMM24[] =
+{
+	OP1(JMZ, VX)
+};
+
+// === JMN ===
+// -- Reg24 --
+static constexpr Instruction JMN_REG24[] =
+{
+	OP1(JMN, RX)
+};
+
+// -- Imm24 --
+static constexpr Instruction JMN_IMM24[] =
+{
+	OP1(JMN, VX)
+};
+
+// === STR ===
+// -- RamReg/ImmReg --
+static constexpr Instruction STR_RAMREG_IMMREG[] =
+{
+	OP1(MOVADDBUS, RX), OP1(MOVDATABUS, R4), OP0(RAMWRITE)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction STR_REG_RAM[] =
+{
+	OP1(MOVADDBUS, VX), OP1(MOVDATABUS, R1), OP0(RAMWRITE)
+};
+
+// === LOD ===
+// -- RamReg/ImmReg --
+static constexpr Instruction LOD_RAMREG_IMMREG[] =
+{
+	OP1(MOVADDBUS, RX), OP0(RAMREAD), OP2(MOVREG, R4, DATABUS)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction LOD_REG_RAM[] =
+{
+	OP1(MOVADDBUS, VX), OP0(RAMREAD), OP2(MOVREG, R1, DATABUS)
+};
+
+// === MOV ===
+// -- Reg --
+static constexpr Instruction MOV_REG[] =
+{
+	OP2(MOVREG, R1, R2)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction MOV_REG_IMM8[] =
+{
+	OP2(MOVREG, R1, V1)
+};
+
+// === NOT ===
+// -- Reg --
+static constexpr Instruction NOT_REG[] =
+{
+	OP1(MOVACC1, R1), OP0(NOT), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Imm24 --
+static constexpr Instruction NOT_IMM24[] =
+{
+	OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC1, DATABUS), OP0(NOT),
+	OP1(MOVADDBUS, VX), OP1(MOVDATABUS, ALUOUT), OP0(RAMWRITE)
+};
+
+// === OR ===
+// -- Reg --
+static constexpr Instruction OR_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, R2), OP0(OR), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction OR_REG_IMM8[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, V1), OP0(OR), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction OR_REG_RAM[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC2, DATABUS),
+	OP0(OR), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === POP ===
+// -- Reg --
+static constexpr Instruction POP_REG[] =
+{
+	OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD), OP2(MOVREG, R1, DATABUS)
+};
+
+// === PSH ===
+// -- Reg --
+static constexpr Instruction PSH_REG[] =
+{
+	OP1(MOVADDBUS, STK), OP1(MOVDATABUS, R1), OP0(RAMWRITE), OP0(INCSTK)
+};
+
+// === RET ===
+// -- None --
+static constexpr Instruction RET_NONE[] =
+{
+	OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD), OP1(MOVPC, DATABUS16),
+	OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD), OP1(MOVPC, PCDATABUS8),
+	OP0(DECSTK), OP1(MOVADDBUS, STK), OP0(RAMREAD), OP1(MOVPC, PCDATABUS),
+	OP0(INCPC)
+};
+
+// === SHL ===
+// -- Reg --
+static constexpr Instruction SHL_REG[] =
+{
+	OP1(MOVACC1, R1), OP0(SHL), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === ASR ===
+// -- Reg --
+static constexpr Instruction ASR_REG[] =
+{
+	OP1(MOVACC1, R1), OP0(ASR), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === SHR ===
+// -- Reg --
+static constexpr Instruction SHR_REG[] =
+{
+	OP1(MOVACC1, R1), OP0(SHR), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === STC ===
+// -- None --
+static constexpr Instruction STC_NONE[] =
+{
+	OP0(STC)
+};
+
+// === STI ===
+// -- None --
+static constexpr Instruction STI_NONE[] =
+{
+	OP0(STI)
+};
+
+// === STN ===
+// -- None --
+static constexpr Instruction STN_NONE[] =
+{
+	OP0(STN)
+};
+
+// === STF ===
+// -- None --
+static constexpr Instruction STF_NONE[] =
+{
+	OP0(STF)
+};
+
+// === STS ===
+// -- None --
+static constexpr Instruction STS_NONE[] =
+{
+	OP0(STS)
+};
+
+// === STE ===
+// -- None --
+static constexpr Instruction STE_NONE[] =
+{
+	OP0(STE)
+};
+
+// === STZ ===
+// -- None --
+static constexpr Instruction STZ_NONE[] =
+{
+	OP0(STZ)
+};
+
+// === SUB ===
+// -- Reg --
+static constexpr Instruction SUB_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, R2), OP0(SUB), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction SUB_REG_IMM8[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, V1), OP0(SUB), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction SUB_REG_RAM[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC2, DATABUS),
+	OP0(SUB), OP2(MOVREG, R1, ALUOUT)
+};
+
+// === XOR ===
+// -- Reg --
+static constexpr Instruction XOR_REG[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, R2), OP0(XOR), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Imm8 --
+static constexpr Instruction XOR_REG_IMM8[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVACC2, V1), OP0(XOR), OP2(MOVREG, R1, ALUOUT)
+};
+
+// -- Reg/Ram --
+static constexpr Instruction XOR_REG_RAM[] =
+{
+	OP1(MOVACC1, R1), OP1(MOVADDBUS, VX), OP0(RAMREAD), OP1(MOVACC2, DATABUS),
+	OP0(XOR), OP2(MOVREG, R1, ALUOUT)
+};
+
+static constexpr codeSequence codeSequences[] =
+{
+	SEQUENCE(ADC, REG, ADC_REG),
+	SEQUENCE(ADC, REG_IMM8, ADC_REG_IMM8),
+	SEQUENCE(ADC, REG_RAM, ADC_REG_RAM),
+	SEQUENCE(ADD, REG, ADD_REG),
+	SEQUENCE(ADD, REG_IMM8, ADD_REG_IMM8),
+	SEQUENCE(ADD, REG_RAM, ADD_REG_RAM),
+	SEQUENCE(AND, REG, AND_REG),
+	SEQUENCE(AND, REG_IMM8, AND_REG_IMM8),
+	SEQUENCE(AND, REG_RAM, AND_REG_RAM),
+	SEQUENCE(CAL, REG24, CAL_REG24),
+	SEQUENCE(CAL, IMM24, CAL_IMM24),
+	SEQUENCE(CLC, NONE, CLC_NONE),
+	SEQUENCE(CLE, NONE, CLE_NONE),
+	SEQUENCE(CLI, NONE, CLI_NONE),
+	SEQUENCE(CLN, NONE, CLN_NONE),
+	SEQUENCE(CLS, NONE, CLS_NONE),
+	SEQUENCE(CLZ, NONE, CLZ_NONE),
+	SEQUENCE(CLF, NONE, CLF_NONE),
+	SEQUENCE(CMP, REG, CMP_REG),
+	SEQUENCE(CMP, REG_IMM8, CMP_REG_IMM8),
+	SEQUENCE(CMP, REG_RAM, CMP_REG_RAM),
+	SEQUENCE(DEC, REG, DEC_REG),
+	SEQUENCE(DEC, REG24, DEC_REG24),
+	SEQUENCE(DEC, IMM24, DEC_IMM24),
+	SEQUENCE(HLT, NONE, HLT_NONE),
+	SEQUENCE(IN, REG, IN_REG),
+	SEQUENCE(OUT, REG, OUT_REG),
+	SEQUENCE(INC, REG, INC_REG),
+	SEQUENCE(INC, REG24, INC_REG24),
+	SEQUENCE(INC, IMM24, INC_IMM24),
+	SEQUENCE(INT, IMM8, INT_IMM8),
+	SEQUENCE(IRT, NONE, IRT_NONE),
+	SEQUENCE(JMC, REG24, JMC_REG24),
+	SEQUENCE(JMC, IMM24, JMC_IMM24),
+	SEQUENCE(JME, REG24, JME_REG24),
+	SEQUENCE(JME, IMM24, JME_IMM24),
+	SEQUENCE(JMF, REG24, JMF_REG24),
+	SEQUENCE(JMF, IMM24, JMF_IMM24),
+	SEQUENCE(JMK, REG24, JMK_REG24),
+	SEQUENCE(JMK, IMM24, JMK_IMM24),
+	SEQUENCE(JMP, REG24, JMP_REG24),
+	SEQUENCE(JMP, IMM24, JMP_IMM24),
+	SEQUENCE(JMS, REG24, JMS_REG24),
+	SEQUENCE(JMS, IMM24, JMS_IMM24),
+	SEQUENCE(JMZ, REG24, JMZ_REG24),
+	SEQUENCE(JMZ, IMM24, JMZ_IMM24),
+	SEQUENCE(JMN, REG24, JMN_REG24),
+	SEQUENCE(JMN, IMM24, JMN_IMM24),
+	SEQUENCE(STR, RAMREG_IMMREG, STR_RAMREG_IMMREG),
+	SEQUENCE(STR, REG_RAM, STR_REG_RAM),
+	SEQUENCE(LOD, RAMREG_IMMREG, LOD_RAMREG_IMMREG),
+	SEQUENCE(LOD, REG_RAM, LOD_REG_RAM),
+	SEQUENCE(MOV, REG, MOV_REG),
+	SEQUENCE(MOV, REG_IMM8, MOV_REG_IMM8),
+	SEQUENCE(NOT, REG, NOT_REG),
+	SEQUENCE(NOT, IMM24, NOT_IMM24),
+	SEQUENCE(OR, REG, OR_REG),
+	SEQUENCE(OR, REG_IMM8, OR_REG_IMM8),
+	SEQUENCE(OR, REG_RAM, OR_REG_RAM),
+	SEQUENCE(POP, REG, POP_REG),
+	SEQUENCE(PSH, REG, PSH_REG),
+	SEQUENCE(RET, NONE, RET_NONE),
+	SEQUENCE(SHL, REG, SHL_REG),
+	SEQUENCE(ASR, REG, ASR_REG),
+	SEQUENCE(SHR, REG, SHR_REG),
+	SEQUENCE(STC, NONE, STC_NONE),
+	SEQUENCE(STI, NONE, STI_NONE),
+	SEQUENCE(STN, NONE, STN_NONE),
+	SEQUENCE(STF, NONE, STF_NONE),
+	SEQUENCE(STS, NONE, STS_NONE),
+	SEQUENCE(STE, NONE, STE_NONE),
+	SEQUENCE(STZ, NONE, STZ_NONE),
+	SEQUENCE(SUB, REG, SUB_REG),
+	SEQUENCE(SUB, REG_IMM8, SUB_REG_IMM8),
+	SEQUENCE(SUB, REG_RAM, SUB_REG_RAM),
+	SEQUENCE(XOR, REG, XOR_REG),
+	SEQUENCE(XOR, REG_IMM8, XOR_REG_IMM8),
+	SEQUENCE(XOR, REG_RAM, XOR_REG_RAM)
+};
+
+#define CODE_SEQUENCES_NB (sizeof(codeSequences) / sizeof(codeSequence))
+
+constexpr uint16_t codeLength()
+{
+	uint16_t length(0);
+
+	for (unsigned int i(0); i < CODE_SEQUENCES_NB; i++)
+	{
+		length += codeSequences[i].length;
+	}
+
+	return length;
+}
+
+static_assert(codeLength() <= CODE_ROM_SIZE, "The code doesn't fit in the code ROM");
+
+constexpr handlersList jumpHandler(operandsList operand, handlersList rxHandler, handlersList vxHandler)
+{
+	return (operand == operandsList::RX) ? rxHandler : (operand == operandsList::VX) ? vxHandler : handlersList::NOP;
+}
+
+// MOVREG handlers are laid out destination by destination in HANDLERS, each one with every source
+static_assert((int)handlersList::MOVREG_I_V1 - (int)handlersList::MOVREG_R1_ALUOUT == 23, "Unexpected MOVREG handlers layout");
+
+constexpr handlersList movRegHandler(operandsList destination, operandsList source)
+{
+	int row(-1), column(-1);
+
+	switch (destination)
+	{
+	case operandsList::R1: row = 0; break;
+	case operandsList::R2: row = 1; break;
+	case operandsList::R4: row = 2; break;
+	case operandsList::I: row = 3; break;
+	default: break;
+	}
+
+	switch (source)
+	{
+	case operandsList::ALUOUT: column = 0; break;
+	case operandsList::DATABUS: column = 1; break;
+	case operandsList::R1: column = 2; break;
+	case operandsList::R2: column = 3; break;
+	case operandsList::R4: column = 4; break;
+	case operandsList::V1: column = 5; break;
+	default: break;
+	}
+
+	if (row < 0 || column < 0) // Nothing to move, as with the former operands switch
+		return handlersList::NOP;
+
+	return (handlersList)((int)handlersList::MOVREG_R1_ALUOUT + row * 6 + column);
+}
+
+// Specializes a instruction for its operands, the pairs that have no effect resolve to NOP
+constexpr handlersList resolvehandler(const Instruction& instruction)
+{
+	const operandsList operand(instruction.uoperands[0]);
+
+	switch (instruction.uopcode)
+	{
+	case opcodesList::ADC: return handlersList::ADC;
+	case opcodesList::ADD: return handlersList::ADD;
+	case opcodesList::SUB: return handlersList::SUB;
+	case opcodesList::AND: return handlersList::AND;
+	case opcodesList::XOR: return handlersList::XOR;
+	case opcodesList::NOT: return handlersList::NOT;
+	case opcodesList::OR: return handlersList::OR;
+	case opcodesList::SHR: return handlersList::SHR;
+	case opcodesList::ASR: return handlersList::ASR;
+	case opcodesList::SHL: return handlersList::SHL;
+	case opcodesList::CMP: return handlersList::CMP;
+	case opcodesList::IN: return handlersList::IN;
+	case opcodesList::OUT: return handlersList::OUT;
+	case opcodesList::INT: return handlersList::INT;
+	case opcodesList::CLC: return handlersList::CLC;
+	case opcodesList::CLE: return handlersList::CLE;
+	case opcodesList::CLI: return handlersList::CLI;
+	case opcodesList::CLN: return handlersList::CLN;
+	case opcodesList::CLS: return handlersList::CLS;
+	case opcodesList::CLZ: return handlersList::CLZ;
+	case opcodesList::CLF: return handlersList::CLF;
+	case opcodesList::STH: return handlersList::STH;
+	case opcodesList::STC: return handlersList::STC;
+	case opcodesList::STI: return handlersList::STI;
+	case opcodesList::STN: return handlersList::STN;
+	case opcodesList::STF: return handlersList::STF;
+	case opcodesList::STS: return handlersList::STS;
+	case opcodesList::STE: return handlersList::STE;
+	case opcodesList::STZ: return handlersList::STZ;
+	case opcodesList::DECSTK: return handlersList::DECSTK;
+	case opcodesList::INCSTK: return handlersList::INCSTK;
+	case opcodesList::INCPC: return handlersList::INCPC;
+	case opcodesList::RAMREAD: return handlersList::RAMREAD;
+	case opcodesList::RAMWRITE: return handlersList::RAMWRITE;
+
+	case opcodesList::MOVACC1:
+		switch (operand)
+		{
+		case operandsList::ALUOUT: return handlersList::MOVACC1_ALUOUT;
+		case operandsList::DATABUS: return handlersList::MOVACC1_DATABUS;
+		case operandsList::R1: return handlersList::MOVACC1_R1;
+		case operandsList::R2: return handlersList::MOVACC1_R2;
+		case operandsList::R4: return handlersList::MOVACC1_R4;
+		case operandsList::V1: return handlersList::MOVACC1_V1;
+		default: break;
+		}
+		break;
+
+	case opcodesList::MOVACC2:
+		switch (operand)
+		{
+		case operandsList::X1: return handlersList::MOVACC2_X1;
+		case operandsList::ALUOUT: return handlersList::MOVACC2_ALUOUT;
+		case operandsList::DATABUS: return handlersList::MOVACC2_DATABUS;
+		case operandsList::R1: return handlersList::MOVACC2_R1;
+		case operandsList::R2: return handlersList::MOVACC2_R2;
+		case operandsList::R4: return handlersList::MOVACC2_R4;
+		case operandsList::V1: return handlersList::MOVACC2_V1;
+		default: break;
+		}
+		break;
+
+	case opcodesList::MOVREG:
+		return movRegHandler(operand, instruction.uoperands[1]);
+
+	case opcodesList::MOVDATABUS:
+		switch (operand)
+		{
+		case operandsList::ALUOUT: return handlersList::MOVDATABUS_ALUOUT;
+		case operandsList::R1: return handlersList::MOVDATABUS_R1;
+		case operandsList::R2: return handlersList::MOVDATABUS_R2;
+		case operandsList::R4: return handlersList::MOVDATABUS_R4;
+		case operandsList::V1: return handlersList::MOVDATABUS_V1;
+		case operandsList::PC_16: return handlersList::MOVDATABUS_PC_16;
+		case operandsList::PC_8: return handlersList::MOVDATABUS_PC_8;
+		case operandsList::PC8: return handlersList::MOVDATABUS_PC8;
+		default: break;
+		}
+		break;
+
+	case opcodesList::MOVADDBUS:
+		switch (operand)
+		{
+		case operandsList::V1: return handlersList::MOVADDBUS_V1;
+		case operandsList::R1: return handlersList::MOVADDBUS_R1;
+		case operandsList::R2: return handlersList::MOVADDBUS_R2;
+		case operandsList::RX: return handlersList::MOVADDBUS_RX;
+		case operandsList::VX: return handlersList::MOVADDBUS_VX;
+		case operandsList::STK: return handlersList::MOVADDBUS_STK;
+		default: break;
+		}
+		break;
+
+	case opcodesList::MOVPC:
+		switch (operand)
+		{
+		case operandsList::RX: return handlersList::MOVPC_RX;
+		case operandsList::VX: return handlersList::MOVPC_VX;
+		case operandsList::DATABUS16: return handlersList::MOVPC_DATABUS16;
+		case operandsList::PCDATABUS8: return handlersList::MOVPC_PCDATABUS8;
+		case operandsList::PCDATABUS: return handlersList::MOVPC_PCDATABUS;
+		default: break;
+		}
+		break;
+
+	case opcodesList::JMC: return jumpHandler(operand, handlersList::JMC_RX, handlersList::JMC_VX);
+	case opcodesList::JME: return jumpHandler(operand, handlersList::JME_RX, handlersList::JME_VX);
+	case opcodesList::JMF: return jumpHandler(operand, handlersList::JMF_RX, handlersList::JMF_VX);
+	case opcodesList::JMK: return jumpHandler(operand, handlersList::JMK_RX, handlersList::JMK_VX);
+	case opcodesList::JMP: return jumpHandler(operand, handlersList::JMP_RX, handlersList::JMP_VX);
+	case opcodesList::JMS: return jumpHandler(operand, handlersList::JMS_RX, handlersList::JMS_VX);
+	case opcodesList::JMZ: return jumpHandler(operand, handlersList::JMZ_RX, handlersList::JMZ_VX);
+	case opcodesList::JMN: return jumpHandler(operand, handlersList::JMN_RX, handlersList::JMN_VX);
+
+	default:
+		break;
+	}
+
+	return handlersList::NOP;
+}
+
+// Lays every sequence out one after the other, instructions that don't exist with an addressing mode keep an empty entry (NOP)
+constexpr codeROMImage burncodeROM()
+{
+	codeROMImage image{};
+	uint16_t romSize(0);
+
+	for (unsigned int i(0); i < CODE_SEQUENCES_NB; i++)
+	{
+		codeEntry& entry(image.index[(int)codeSequences[i].instruction][(int)codeSequences[i].addressingMode]);
+
+		entry.start = romSize;
+		entry.length = codeSequences[i].length;
+
+		for (unsigned int j(0); j < codeSequences[i].length; j++)
+		{
+			image.rom[romSize] = codeSequences[i].code[j];
+			image.handlers[romSize] = resolvehandler(image.rom[romSize]);
+			romSize++;
+		}
+	}
+
+	return image;
+}
+
+constexpr codeROMImage codeROM = burncodeROM();
+
+constexpr bool handlersResolved()
+{
+	for (unsigned int i(0); i < codeLength(); i++)
+	{
+		if (codeROM.handlers[i] == handlersList::NOP)
+			return false;
+	}
+
+	return true;
+}
+
+static_assert(handlersResolved(), "A instruction of the code ROM has no effect with its operands");
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "defines.hpp"
+
+#define INSTRUCTIONS_NB 48 // Including NOP (0x0 by definition)
+#define ADDRESSING_MODES_NB 8
+
+#define OPCODE_VALUES_NB 64 // The opcode field is 6 bits long, unused opcodes execute as NOP
+#define ADDRESSING_MODE_VALUES_NB 16 // The addressing mode field is 4 bits long
+#define CODE_ROM_SIZE 512 // In instructions, all instructions included
+#define OPERANDS_MAX 2
+
+enum class InstructionsList {NOP = 0x0,  ADC = 0x1,  ADD = 0x2,  AND = 0x3,  CAL = 0x4,  CLC = 0x5,  CLE = 0x6,  CLI = 0x7,  CLN = 0x8,  CLS = 0x9,  CLZ = 0xA,  CLF = 0xB,
+							 CMP = 0xC,  DEC = 0xD,  HLT = 0xE,  IN = 0xF,   OUT = 0x10, INC = 0x11, INT = 0x12, IRT = 0x13, JMC = 0x14, JME = 0x15, JMF = 0x16, JMK = 0x17,
+							 JMP = 0x18, JMS = 0x19, JMZ = 0x1A, JMN = 0x1B, STR = 0x1C, LOD = 0x1D, MOV = 0x1E, NOT = 0x1F, OR = 0x20,  POP = 0x21, PSH = 0x22, RET = 0x23,
+							 SHL = 0x24, ASR = 0x25, SHR = 0x26, STC = 0x27, STI = 0x28, STN = 0x29, STF = 0x2A, STS = 0x2B, STE = 0x2C, STZ = 0x2D, SUB = 0x2E, XOR = 0x2F};
+
+enum class AddressingModesList {NONE = 0x0, REG = 0x1, REG_IMM8 = 0x2, REG_RAM = 0x3, RAMREG_IMMREG = 0x4, REG24 = 0x5, IMM24 = 0x6, IMM8 = 0x7};
+
+enum class opcodesList : uint8_t {MOVACC1, MOVACC2, MOVPC, MOVADDBUS, MOVDATABUS, MOVREG, RAMREAD, RAMWRITE, DECSTK, INCSTK, CLC, CLE, CLI, CLN, CLS, CLZ, CLF, STH, STC, STI,
+						 STN, STF, STS, STE, STZ, JMC, JME, JMF, JMK, JMP, JMS, JMZ, JMN, IN, OUT, INT, ADC, ADD, SUB, AND, OR, XOR, NOT, SHL, ASR, SHR, CMP, INCPC, UNDEFINED};
+
+enum class operandsList : uint8_t {R1, R2, R4, V1, VX, RX, ALUOUT, DATABUS, DATABUS16, PCDATABUS8, PCDATABUS, STK, X1, PC_16, PC_8, PC8, I};
+
+typedef struct // Flat instruction, as stored in the code ROM
+{
+	opcodesList uopcode;
+	operandsList uoperands[OPERANDS_MAX]; // Unused operands are never read
+} Instruction;
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(NO_COMPUTED_GOTO)
+#define CODE_COMPUTED_GOTO // Labels as values, the instructions are dispatched with a switch on other compilers
+#endif
+
+// Every opcode specialized for its operands, so executing a instruction takes a single dispatch
+#define HANDLERS(HANDLER) \
+	HANDLER(NOP) HANDLER(ADC) HANDLER(ADD) HANDLER(SUB) HANDLER(AND) HANDLER(XOR) HANDLER(NOT) HANDLER(OR) HANDLER(SHR) HANDLER(ASR) HANDLER(SHL) HANDLER(CMP) \
+	HANDLER(IN) HANDLER(OUT) HANDLER(INT) \
+	HANDLER(CLC) HANDLER(CLE) HANDLER(CLI) HANDLER(CLN) HANDLER(CLS) HANDLER(CLZ) HANDLER(CLF) \
+	HANDLER(STH) HANDLER(STC) HANDLER(STI) HANDLER(STN) HANDLER(STF) HANDLER(STS) HANDLER(STE) HANDLER(STZ) \
+	HANDLER(DECSTK) HANDLER(INCSTK) HANDLER(INCPC) HANDLER(RAMREAD) HANDLER(RAMWRITE) \
+	HANDLER(MOVACC1_ALUOUT) HANDLER(MOVACC1_DATABUS) HANDLER(MOVACC1_R1) HANDLER(MOVACC1_R2) HANDLER(MOVACC1_R4) HANDLER(MOVACC1_V1) \
+	HANDLER(MOVACC2_X1) HANDLER(MOVACC2_ALUOUT) HANDLER(MOVACC2_DATABUS) HANDLER(MOVACC2_R1) HANDLER(MOVACC2_R2) HANDLER(MOVACC2_R4) HANDLER(MOVACC2_V1) \
+	HANDLER(MOVREG_R1_ALUOUT) HANDLER(MOVREG_R1_DATABUS) HANDLER(MOVREG_R1_R1) HANDLER(MOVREG_R1_R2) HANDLER(MOVREG_R1_R4) HANDLER(MOVREG_R1_V1) \
+	HANDLER(MOVREG_R2_ALUOUT) HANDLER(MOVREG_R2_DATABUS) HANDLER(MOVREG_R2_R1) HANDLER(MOVREG_R2_R2) HANDLER(MOVREG_R2_R4) HANDLER(MOVREG_R2_V1) \
+	HANDLER(MOVREG_R4_ALUOUT) HANDLER(MOVREG_R4_DATABUS) HANDLER(MOVREG_R4_R1) HANDLER(MOVREG_R4_R2) HANDLER(MOVREG_R4_R4) HANDLER(MOVREG_R4_V1) \
+	HANDLER(MOVREG_I_ALUOUT) HANDLER(MOVREG_I_DATABUS) HANDLER(MOVREG_I_R1) HANDLER(MOVREG_I_R2) HANDLER(MOVREG_I_R4) HANDLER(MOVREG_I_V1) \
+	HANDLER(MOVDATABUS_ALUOUT) HANDLER(MOVDATABUS_R1) HANDLER(MOVDATABUS_R2) HANDLER(MOVDATABUS_R4) HANDLER(MOVDATABUS_V1) \
+	HANDLER(MOVDATABUS_PC_16) HANDLER(MOVDATABUS_PC_8) HANDLER(MOVDATABUS_PC8) \
+	HANDLER(MOVADDBUS_V1) HANDLER(MOVADDBUS_R1) HANDLER(MOVADDBUS_R2) HANDLER(MOVADDBUS_RX) HANDLER(MOVADDBUS_VX) HANDLER(MOVADDBUS_STK) \
+	HANDLER(MOVPC_RX) HANDLER(MOVPC_VX) HANDLER(MOVPC_DATABUS16) HANDLER(MOVPC_PCDATABUS8) HANDLER(MOVPC_PCDATABUS) \
+	HANDLER(JMC_RX) HANDLER(JMC_VX) HANDLER(JME_RX) HANDLER(JME_VX) HANDLER(JMF_RX) HANDLER(JMF_VX) HANDLER(JMK_RX) HANDLER(JMK_VX) \
+	HANDLER(JMP_RX) HANDLER(JMP_VX) HANDLER(JMS_RX) HANDLER(JMS_VX) HANDLER(JMZ_RX) HANDLER(JMZ_VX) HANDLER(JMN_RX) HANDLER(JMN_VX)
+
+#define HANDLER_ENUM(handler) handler,
+enum class handlersList : uint8_t {HANDLERS(HANDLER_ENUM)}; // NOP for the pairs without any effect
+#undef HANDLER_ENUM
+
+typedef struct
+{
+	uint16_t start; // Index of the first instruction in the code ROM
+	uint16_t length; // 0 if the instruction doesn't exist with this addressing mode
+} codeEntry;
+
+typedef struct // Whole code of the CPU, built at compile time
+{
+	Instruction rom[CODE_ROM_SIZE];
+	handlersList handlers[CODE_ROM_SIZE]; // Handler of each instruction, resolved while burning the ROM
+	codeEntry index[OPCODE_VALUES_NB][ADDRESSING_MODE_VALUES_NB];
+} codeROMImage;
+
+extern const codeROMImage codeROM; // Read-only, shared by every CPU instance
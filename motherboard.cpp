@@ -1,4 +1,6 @@
 #include "motherboard.hpp"
+#include "scheduler.hpp"
+#include "ram.hpp"
 
 Motherboard::Motherboard()
 {
@@ -11,10 +13,21 @@ Motherboard::Motherboard()
 	m_dataBus = 0;
 	m_addressBus = 0;
 
+	m_ram = nullptr;
+	m_memory = nullptr;
+	m_scheduler = nullptr;
+
 	for (unsigned int i(0); i < PORTS_NB; i++)
 	{
 		m_ports[i].first = nullptr;
 	}
+
+	for (unsigned int i(0); i < INTERRUPT_MASK_WORDS; i++)
+	{
+		m_pendingInterrupts[i] = 0;
+	}
+
+	m_pendingInterruptWords = 0;
 }
 
 Motherboard::~Motherboard()
@@ -48,6 +61,22 @@ void Motherboard::setAddressBus(uint32_t address)
 	m_addressBus = address & 0x00FFFFFF; // Discards the two most significant bytes in the 32-bit integer variable
 }
 
+RAM* Motherboard::getRAM()
+{
+	return m_ram;
+}
+
+void Motherboard::plugRAM(RAM* ram)
+{
+	m_ram = ram;
+	m_memory = (ram != nullptr) ? ram->getMemory() : nullptr;
+}
+
+void Motherboard::write8(uint8_t data, uint32_t address)
+{
+	m_ram->setData(data, address & 0x00FFFFFF);
+}
+
 Device* Motherboard::getDevice(uint8_t portID)
 {
 	return m_ports[portID].first;
@@ -65,6 +94,11 @@ bool Motherboard::plugDevice(Device* dev)
 				m_ports[i + j].second = j;
 			}
 
+			dev->plug(this, (uint8_t)i);
+
+			if (dev->getINT())
+				setInterruptPending((uint8_t)i, true);
+
 			return true;
 		}
 	}
@@ -78,6 +112,9 @@ void Motherboard::unplugDevice(Device* dev)
 	{
 		if (m_ports[i].first == dev)
 		{
+			setInterruptPending((uint8_t)i, false);
+			dev->plug(nullptr, 0);
+
 			for (unsigned int j(0); m_ports[i + j].first == dev; j++)
 			{
 				m_ports[i + j].first = nullptr;
@@ -94,6 +131,9 @@ void Motherboard::setPortData(uint8_t data, uint8_t portNb)
 	if (m_ports[portNb].first != nullptr)
 	{
 		m_ports[portNb].first->setData(data, m_ports[portNb].second);
+
+		if (m_ports[portNb].first->onPortWrite(m_ports[portNb].second) && m_scheduler != nullptr)
+			m_scheduler->wake(m_ports[portNb].first);
 	}
 }
 
@@ -107,6 +147,41 @@ uint8_t Motherboard::getPortData(uint8_t portNb)
 	return 0x00; // Default value
 }
 
+void Motherboard::setScheduler(Scheduler* scheduler)
+{
+	m_scheduler = scheduler;
+}
+
+void Motherboard::setInterruptPending(uint8_t portNb, bool pending)
+{
+	unsigned int word(portNb / 64);
+
+	if (pending)
+		m_pendingInterrupts[word] |= (uint64_t)1 << (portNb % 64);
+	else
+		m_pendingInterrupts[word] &= ~((uint64_t)1 << (portNb % 64));
+
+	if (m_pendingInterrupts[word] != 0)
+		m_pendingInterruptWords |= (uint64_t)1 << word;
+	else
+		m_pendingInterruptWords &= ~((uint64_t)1 << word);
+}
+
+uint64_t Motherboard::getPendingInterrupts(unsigned int word)
+{
+	return m_pendingInterrupts[word];
+}
+
+uint64_t Motherboard::getPendingInterruptWords()
+{
+	return m_pendingInterruptWords;
+}
+
+bool Motherboard::hasPendingInterrupts()
+{
+	return m_pendingInterruptWords != 0;
+}
+
 bool Motherboard::getRW()
 {
 	return m_rw;
@@ -3,6 +3,10 @@
 #include "device.hpp"
 
 #define PORTS_NB 256
+#define INTERRUPT_MASK_WORDS (PORTS_NB / 64)
+
+class RAM;
+class Scheduler;
 
 class Motherboard
 {
@@ -16,12 +20,43 @@ public:
 	void setDataBus(uint8_t data);
 	void setAddressBus(uint32_t address);
 
+	// RAM
+	RAM* getRAM();
+	void plugRAM(RAM* ram);
+
+	// Direct memory interface for the instruction-level engines, without the bus handshake (the code engine and the diagram keep the pins)
+	uint8_t read8(uint32_t address)
+	{
+		return m_memory[address & 0x00FFFFFF];
+	}
+
+	uint64_t read40(uint32_t address) // Instruction, most significant byte first
+	{
+		address &= 0x00FFFFFF;
+
+		if (address > 0x00FFFFFF - 4) // Wraps around the end of the address space
+			return ((uint64_t)read8(address) << 32) + ((uint64_t)read8(address + 1) << 24) + ((uint64_t)read8(address + 2) << 16) + ((uint64_t)read8(address + 3) << 8) + (uint64_t)read8(address + 4);
+
+		const uint8_t* bytes(m_memory + address);
+
+		return ((uint64_t)bytes[0] << 32) + ((uint64_t)bytes[1] << 24) + ((uint64_t)bytes[2] << 16) + ((uint64_t)bytes[3] << 8) + (uint64_t)bytes[4];
+	}
+
+	void write8(uint8_t data, uint32_t address); // Through the RAM chip, so the caches listening to its writes are notified
+
 	// I/O
 	Device* getDevice(uint8_t portID);
 	bool plugDevice(Device* dev);
 	void unplugDevice(Device* dev);
 	void setPortData(uint8_t data, uint8_t portNb);
 	uint8_t getPortData(uint8_t portNb);
+	void setScheduler(Scheduler* scheduler); // The devices are woken up by the writes into their ports
+
+	// Interrupts raised by the devices, one bit per port (the first port of the device)
+	void setInterruptPending(uint8_t portNb, bool pending);
+	uint64_t getPendingInterrupts(unsigned int word); // Ports word * 64 to word * 64 + 63
+	uint64_t getPendingInterruptWords(); // Bit i = word i of the mask isn't empty
+	bool hasPendingInterrupts();
 
 	bool getRW();
 	bool getRE();
@@ -45,5 +80,12 @@ private:
 	uint8_t m_dataBus;
 	uint32_t m_addressBus;
 
+	RAM* m_ram; // Only used by the instruction-level engines, the code engine goes through the buses
+	uint8_t* m_memory; // Content of the RAM chip, for the direct reads
+	Scheduler* m_scheduler;
+
+	uint64_t m_pendingInterrupts[INTERRUPT_MASK_WORDS];
+	uint64_t m_pendingInterruptWords;
+
 	std::pair<Device*, uint8_t> m_ports[PORTS_NB]; // The uint8_t value stands for the port nb on device side
 };
@@ -1,14 +1,41 @@
 #include "ram.hpp"
 
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+MemoryWriteListener::~MemoryWriteListener()
+{
+
+}
+
 RAM::RAM(Motherboard* mb)
 {
 	m_mb = mb;
 
-	for (unsigned int i(0); i < RAM_SIZE; i++)
+	for (unsigned int i(0); i < RAM_PAGES_NB / 64; i++)
 	{
-		m_memory[i] = 0x00;
+		m_watchedPages[i] = 0;
 	}
 
+	allocateMemory(); // Already zeroed
+
+	if (m_mb != nullptr)
+		m_mb->plugRAM(this);
+}
+
+RAM::~RAM()
+{
+	if (m_mb != nullptr && m_mb->getRAM() == this)
+		m_mb->plugRAM(nullptr);
+
+	freeMemory();
+}
+
+void RAM::loadDemoProgram()
+{
 	set5bData(0xF000000000, 0x00010C);
 	set5bData(0x4C00000000, 0xF00000);
 
@@ -90,7 +117,6 @@ void RAM::tick()
 	}
 }
 
-// PRIVATE
 uint8_t RAM::getData(uint32_t address)
 {
 	return m_memory[address];
@@ -99,6 +125,14 @@ uint8_t RAM::getData(uint32_t address)
 void RAM::setData(uint8_t data, uint32_t address)
 {
 	m_memory[address] = data;
+
+	if (m_watchedPages[address >> 14] & ((uint64_t)1 << ((address >> 8) & 0x3F))) // Bit of the page in the bitmap
+	{
+		for (unsigned int i(0); i < m_writeListeners.size(); i++)
+		{
+			m_writeListeners[i]->onMemoryWrite(address);
+		}
+	}
 }
 
 void RAM::set5bData(uint64_t data, uint32_t address)
@@ -113,14 +147,75 @@ void RAM::set5bData(uint64_t data, uint32_t address)
 		uint8_t byte4((uint8_t)((data & 0x000000000000FF00) >> 8));
 		uint8_t byte5((uint8_t)(data & 0x00000000000000FF));
 
-		m_memory[address] = byte1;
-		m_memory[address + 1] = byte2;
-		m_memory[address + 2] = byte3;
-		m_memory[address + 3] = byte4;
-		m_memory[address + 4] = byte5;
+		setData(byte1, address);
+		setData(byte2, address + 1);
+		setData(byte3, address + 2);
+		setData(byte4, address + 3);
+		setData(byte5, address + 4);
+	}
+}
+
+bool RAM::load(const uint8_t* data, uint32_t size, uint32_t address)
+{
+	if (address >= RAM_SIZE || size > RAM_SIZE - address)
+		return false;
+
+	memcpy(m_memory + address, data, size);
+
+	for (uint32_t page(address / RAM_PAGE_SIZE); size > 0 && page <= (address + size - 1) / RAM_PAGE_SIZE; page++) // Only the watched pages are written byte by byte to the listeners
+	{
+		if (!(m_watchedPages[page >> 6] & ((uint64_t)1 << (page & 0x3F))))
+			continue;
+
+		uint32_t start(std::max(address, page * RAM_PAGE_SIZE)), end(std::min(address + size, (page + 1) * RAM_PAGE_SIZE));
+
+		for (uint32_t written(start); written < end; written++)
+		{
+			for (unsigned int i(0); i < m_writeListeners.size(); i++)
+			{
+				m_writeListeners[i]->onMemoryWrite(written);
+			}
+		}
+	}
+
+	return true;
+}
+
+void RAM::addWriteListener(MemoryWriteListener* listener)
+{
+	m_writeListeners.push_back(listener);
+}
+
+void RAM::removeWriteListener(MemoryWriteListener* listener)
+{
+	for (unsigned int i(0); i < m_writeListeners.size(); i++)
+	{
+		if (m_writeListeners[i] == listener)
+		{
+			m_writeListeners.erase(m_writeListeners.begin() + i);
+			break;
+		}
 	}
 }
 
+uint8_t* RAM::getMemory()
+{
+	return m_memory;
+}
+
+const uint64_t* RAM::getWatchedPages()
+{
+	return m_watchedPages;
+}
+
+void RAM::watchPage(uint32_t address)
+{
+	address &= 0x00FFFFFF;
+
+	m_watchedPages[address >> 14] |= (uint64_t)1 << ((address >> 8) & 0x3F);
+}
+
+// PRIVATE
 void RAM::dumpData(uint32_t startAddress, uint32_t endAddress)
 {
 	uint8_t value(0x00);
@@ -149,3 +244,44 @@ void RAM::dumpData(uint32_t startAddress, uint32_t endAddress)
 		std::cout << "===================================================" << std::endl;
 	}
 }
+
+void RAM::allocateMemory()
+{
+	m_mapped = true;
+
+#if defined(_WIN32)
+	m_memory = (uint8_t*)VirtualAlloc(nullptr, RAM_SIZE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE); // Committed pages are only backed once touched
+#else
+	void* memory(MAP_FAILED);
+
+#if defined(RAM_HUGE_PAGES) && defined(MAP_HUGETLB)
+	memory = mmap(nullptr, RAM_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE | MAP_HUGETLB, -1, 0);
+#endif
+
+	if (memory == MAP_FAILED)
+		memory = mmap(nullptr, RAM_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+
+	m_memory = (memory != MAP_FAILED) ? (uint8_t*)memory : nullptr;
+#endif
+
+	if (m_memory == nullptr) // Allocated and zeroed at once
+	{
+		m_mapped = false;
+		m_memory = new uint8_t[RAM_SIZE]();
+	}
+}
+
+void RAM::freeMemory()
+{
+	if (!m_mapped)
+		delete[] m_memory;
+#if defined(_WIN32)
+	else
+		VirtualFree(m_memory, 0, MEM_RELEASE);
+#else
+	else
+		munmap(m_memory, RAM_SIZE);
+#endif
+
+	m_memory = nullptr;
+}
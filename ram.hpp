@@ -4,21 +4,53 @@
 #include "motherboard.hpp"
 
 #define RAM_SIZE 16777216
+#define RAM_PAGE_SIZE 256 // Granularity of the write watching
+#define RAM_PAGES_NB (RAM_SIZE / RAM_PAGE_SIZE)
+//#define RAM_HUGE_PAGES // Asks for 2 MB pages first (Linux only, the huge pages must be reserved on the host), fewer TLB misses but each touched page is a whole 2 MB
+
+// Notified of the writes into the watched pages of the RAM chip, used by the caches built from the RAM content
+class MemoryWriteListener
+{
+	public:
+		virtual ~MemoryWriteListener();
+
+		virtual void onMemoryWrite(uint32_t address) = 0;
+};
 
 class RAM
 {
 	public:
 		RAM(Motherboard* mb);
+		~RAM();
 
 		void tick();
 
-	private:
 		uint8_t getData(uint32_t address);
 		void setData(uint8_t data, uint32_t address);
 		void set5bData(uint64_t data, uint32_t address); // To set instructions manually
+		bool load(const uint8_t* data, uint32_t size, uint32_t address); // Block copy, false if it doesn't fit in the address space
+		void loadDemoProgram(); // Draws "Hello" on the screen, booted when no program image is given
+
+		// Write watching
+		void addWriteListener(MemoryWriteListener* listener);
+		void removeWriteListener(MemoryWriteListener* listener);
+		void watchPage(uint32_t address); // Writes into the page holding this address are notified to all the listeners from now on
+
+		// Direct access for the compiled code, which must go through setData() for the watched pages
+		uint8_t* getMemory();
+		const uint64_t* getWatchedPages();
+
+	private:
 		void dumpData(uint32_t startAddress, uint32_t endAddress);
+		void allocateMemory();
+		void freeMemory();
 
 		Motherboard* m_mb;
 
-		uint8_t m_memory[RAM_SIZE];
+		uint8_t* m_memory; // Zeroed pages provided by the host on their first access, so only the pages touched by the guest are resident
+		bool m_mapped; // False if the host memory couldn't be mapped and had to be allocated and zeroed at once
+
+		std::vector<MemoryWriteListener*> m_writeListeners;
+		uint64_t m_watchedPages[RAM_PAGES_NB / 64]; // One bit per page
+
 };
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "defines.hpp"
+#include "alignednew.hpp"
+
+// Fixed-capacity FIFO for a single thread, push and pop in O(1) without any allocation
+// The buffer is cache line aligned, a class that embeds it and is allocated with new needs CACHE_ALIGNED_NEW
+template <typename T, size_t N>
+class RingBuffer
+{
+	static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer capacity must be a power of two");
+
+	public:
+		RingBuffer() : m_head(0), m_tail(0)
+		{
+
+		}
+
+		bool push(const T& value) // Returns false if the buffer is full
+		{
+			if (m_tail - m_head >= N)
+				return false;
+
+			m_buffer[m_tail & (N - 1)] = value;
+			m_tail++;
+
+			return true;
+		}
+
+		bool pop(T& value) // Returns false if the buffer is empty
+		{
+			if (m_head == m_tail)
+				return false;
+
+			value = m_buffer[m_head & (N - 1)];
+			m_head++;
+
+			return true;
+		}
+
+		const T& front() const // The buffer must not be empty
+		{
+			return m_buffer[m_head & (N - 1)];
+		}
+
+		bool empty() const
+		{
+			return m_head == m_tail;
+		}
+
+		bool full() const
+		{
+			return m_tail - m_head >= N;
+		}
+
+		size_t size() const
+		{
+			return m_tail - m_head;
+		}
+
+	private:
+		size_t m_head; // Both only ever increase, the slot is their value modulo N
+		size_t m_tail;
+		alignas(CACHE_LINE_SIZE) T m_buffer[N];
+};
@@ -0,0 +1,79 @@
+#include "scheduler.hpp"
+
+static bool laterEvent(const DeviceEvent& a, const DeviceEvent& b) // Heap order, earliest on top
+{
+	return a.cycle > b.cycle;
+}
+
+Scheduler::Scheduler()
+{
+	m_cycle = 0;
+	m_ticks = 0;
+}
+
+void Scheduler::schedule(Device* dev, uint64_t cycle)
+{
+	if (dev->getWakeUpCycle() <= cycle)
+		return;
+
+	dev->setWakeUpCycle(cycle);
+
+	m_events.push_back({ cycle, dev });
+	std::push_heap(m_events.begin(), m_events.end(), laterEvent);
+}
+
+void Scheduler::wake(Device* dev)
+{
+	schedule(dev, m_cycle);
+}
+
+void Scheduler::runDueDevices()
+{
+	while (!m_events.empty() && m_events.front().cycle <= m_cycle)
+	{
+		DeviceEvent evt(m_events.front());
+
+		popEvent();
+
+		if (evt.device->getWakeUpCycle() != evt.cycle) // Outdated
+			continue;
+
+		evt.device->setWakeUpCycle(DEVICE_NO_EVENT);
+		evt.device->tick();
+		m_ticks++;
+
+		uint64_t nextEvent(evt.device->getNextEvent());
+
+		if (nextEvent != DEVICE_NO_EVENT)
+			schedule(evt.device, m_cycle + 1 + nextEvent);
+	}
+}
+
+// GETTERS
+uint64_t Scheduler::getNextEvent()
+{
+	while (!m_events.empty() && m_events.front().device->getWakeUpCycle() != m_events.front().cycle)
+	{
+		popEvent();
+	}
+
+	return m_events.empty() ? DEVICE_NO_EVENT : m_events.front().cycle;
+}
+
+uint64_t Scheduler::getTicks()
+{
+	return m_ticks;
+}
+
+// SETTERS
+void Scheduler::setCycle(uint64_t cycle)
+{
+	m_cycle = cycle;
+}
+
+// PRIVATE
+void Scheduler::popEvent()
+{
+	std::pop_heap(m_events.begin(), m_events.end(), laterEvent);
+	m_events.pop_back();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "defines.hpp"
+#include "device.hpp"
+
+typedef struct
+{
+	uint64_t cycle;
+	Device* device;
+} DeviceEvent;
+
+// Wake-ups of the devices, in a min-heap ordered by cycle : a device with nothing to do isn't in it, so it costs nothing
+class Scheduler
+{
+	public:
+		Scheduler();
+
+		void schedule(Device* dev, uint64_t cycle); // A wake-up already scheduled earlier is kept
+		void wake(Device* dev); // On the current cycle, after a write into its ports for instance
+		void runDueDevices(); // Ticks the devices due on the current cycle or before
+
+		// Getters
+		uint64_t getNextEvent(); // Cycle of the earliest wake-up, DEVICE_NO_EVENT if no device is scheduled
+		uint64_t getTicks(); // Device ticks run since power on
+
+		// Setters
+		void setCycle(uint64_t cycle);
+
+	private:
+		void popEvent();
+
+		std::vector<DeviceEvent> m_events; // Outdated events (the device has been rescheduled earlier since) are dropped when they come out
+		uint64_t m_cycle;
+		uint64_t m_ticks;
+};
@@ -1,107 +1,212 @@
 #include "screen.hpp"
 
-Screen::Screen(Keyboard* k)
+Screen::Screen(Display* display)
 {
-	m_keyboard = k;
-
-	m_screenWindow = new sf::RenderWindow(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "HBC-2 Emulator - Monitor", sf::Style::Titlebar);
-	clearScreen();
-	m_evt = new sf::Event();
-
-	m_characterMap = new sf::Texture();
-	m_characterMap->loadFromFile("ascii_character_map.png");
-
-	m_charToDisplay = new sf::RectangleShape(sf::Vector2f(CHAR_WIDTH, CHAR_HEIGHT));
-	m_charToDisplay->setScale(PIXEL_WIDTH, PIXEL_WIDTH);
+	m_display = display; // The screen takes ownership of its display backend
+	m_vram = nullptr;
 
 	m_ports.push_back(0x00); // Port 0 = CHARACTER CODE (CHAR)
 	m_ports.push_back(0x00); // Port 1 = POS X (POS_X)
 	m_ports.push_back(0x00); // Port 2 = POS Y (POS_Y)
 	m_ports.push_back(0x00); // Port 3 = COMMAND (CMD)
 
-	m_screenRefreshed = false;
+	memset(m_cells, 0, sizeof(m_cells));
+	memset(m_dirtyCells, 0, sizeof(m_dirtyCells));
+
+	m_framePending = false;
+	setMaxFPS(SCREEN_MAX_FPS);
+	m_lastPresentation = std::chrono::steady_clock::now() - m_frameInterval; // The first frame is shown at once
+
+	m_presentedFrames = 0;
+	m_coalescedRefreshes = 0;
+	m_skippedRefreshes = 0;
 }
 
 Screen::~Screen()
 {
-	delete m_evt;
-	delete m_characterMap;
-	delete m_charToDisplay;
-	delete m_screenWindow;
+	if (m_vram != nullptr)
+		m_vram->removeWriteListener(this);
+
+	delete m_display;
 }
 
 void Screen::tick()
 {
-	while (m_screenWindow->pollEvent(*m_evt))
+	runCommands();
+
+	if (m_framePending)
+		presentIfDue();
+}
+
+bool Screen::onPortWrite(uint8_t portNb)
+{
+	if (portNb != (uint8_t)Port::CMD || m_ports[portNb] == 0x00) // The other ports only hold the arguments of the next command
+		return false;
+
+	if (m_commands.full()) // Burst of commands longer than the queue
+		runCommands();
+
+	m_commands.push({ m_ports[(uint8_t)Port::CMD], (char)m_ports[(uint8_t)Port::CHAR], m_ports[(uint8_t)Port::POS_X], m_ports[(uint8_t)Port::POS_Y] });
+
+	return true;
+}
+
+void Screen::presentIfDue(bool force)
+{
+	if (!m_framePending)
+		return;
+
+	std::chrono::steady_clock::time_point now(std::chrono::steady_clock::now());
+
+	if (!force && now - m_lastPresentation < m_frameInterval)
+		return;
+
+	m_display->present(m_cells, m_dirtyCells);
+
+	memset(m_dirtyCells, 0, sizeof(m_dirtyCells));
+	m_framePending = false;
+	m_lastPresentation = now;
+	m_presentedFrames++;
+}
+
+void Screen::mapVRAM(RAM* ram)
+{
+	if (m_vram != nullptr)
+		return;
+
+	m_vram = ram;
+	m_vram->addWriteListener(this);
+
+	for (uint32_t address(VRAM_START_ADDRESS); address < VRAM_START_ADDRESS + VRAM_SIZE; address += RAM_PAGE_SIZE)
 	{
-		if (m_evt->type == sf::Event::KeyPressed)
-		{
-			if (m_keyboard != nullptr)
-			{
-				m_keyboard->receiveKeyCode(m_evt->key.code, true); // This is supposed to be keyboard work only, but it is the window that handles key hits in SFML
-			}
-		}
-		else if (m_evt->type == sf::Event::KeyReleased)
-		{
-			if (m_keyboard != nullptr)
-			{
-				m_keyboard->receiveKeyCode(m_evt->key.code, false); // This is supposed to be keyboard work only, but it is the window that handles key hits in SFML
-			}
-		}
+		m_vram->watchPage(address);
 	}
 
-	switch (m_ports[(uint8_t)Port::CMD])
+	m_vram->watchPage(VRAM_START_ADDRESS + VRAM_SIZE - 1);
+
+	for (uint32_t address(VRAM_START_ADDRESS); address < VRAM_START_ADDRESS + VRAM_SIZE; address++) // What the VRAM already holds
 	{
-		case (uint8_t)Cmd::REFRESH:
-			if (!m_screenRefreshed)
-			{
-				refreshScreen();
+		onMemoryWrite(address);
+	}
+}
 
-				m_screenRefreshed = true;
-			}
-			break;
+void Screen::onMemoryWrite(uint32_t address) // Also called for the writes into the pages watched by the CPU caches
+{
+	uint32_t cell(address - VRAM_START_ADDRESS);
 
-		case (uint8_t)Cmd::DRAW:
-			drawCharacter(m_ports[(uint8_t)Port::CHAR], m_ports[(uint8_t)Port::POS_X], m_ports[(uint8_t)Port::POS_Y]);
-			break;
+	if (cell >= VRAM_SIZE)
+		return;
 
-		case (uint8_t)Cmd::CLEAR:
-			clearScreen();
-			break;
+	char c((char)m_vram->getData(address));
 
-		default:
-			m_screenRefreshed = false;
-	}
+	if (setCell(cell, (c >= 32 && c <= 126) ? c : 0)) // Any other code leaves the cell empty
+		m_framePending = true; // Presented at the end of the batch, within the frame rate limit
+}
+
+// GETTERS
+char Screen::getCharacter(uint8_t row, uint8_t line)
+{
+	if (row >= SCREEN_CHAR_WIDTH || line >= SCREEN_CHAR_HEIGHT)
+		return 0;
+
+	return m_cells[line * SCREEN_CHAR_WIDTH + row];
+}
+
+const char* Screen::getCells()
+{
+	return m_cells;
+}
+
+uint64_t Screen::getPresentedFrames()
+{
+	return m_presentedFrames;
+}
+
+uint64_t Screen::getCoalescedRefreshes()
+{
+	return m_coalescedRefreshes;
+}
+
+uint64_t Screen::getSkippedRefreshes()
+{
+	return m_skippedRefreshes;
+}
+
+// SETTERS
+void Screen::setMaxFPS(unsigned int fps)
+{
+	if (fps == 0)
+		m_frameInterval = std::chrono::steady_clock::duration::zero();
+	else
+		m_frameInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / fps));
 }
 
 // PRIVATE
-void Screen::drawCharacter(char c, uint8_t row, uint8_t line)
+void Screen::runCommands() // Each command written runs exactly once
 {
-	int charX(0), charY(0); // Used to select the right character in the character map
+	ScreenCommand command;
 
-	if (c >= 32 && c <= 126 && row < SCREEN_CHAR_WIDTH && line < SCREEN_CHAR_HEIGHT) // ' ' is the first character to be displayable, '~' is the last
+	while (m_commands.pop(command))
 	{
-		c -= 32; // Set it to 0;
+		switch (command.cmd)
+		{
+			case (uint8_t)Cmd::REFRESH:
+				refreshScreen();
+				break;
 
-		charX = c % 16; // 16 characters per line in the character map
-		charY = c / 16;
+			case (uint8_t)Cmd::DRAW:
+				drawCharacter(command.c, command.row, command.line);
+				break;
 
-		m_charToDisplay->setTexture(m_characterMap);
-		m_charToDisplay->setTextureRect(sf::IntRect(charX * CHAR_WIDTH, charY * CHAR_HEIGHT, CHAR_WIDTH, CHAR_HEIGHT)); // Picking just one character in the map
+			case (uint8_t)Cmd::CLEAR:
+				clearScreen();
+				break;
+		}
+	}
+}
 
-		m_charToDisplay->setPosition((float)(row * CHAR_WIDTH * PIXEL_WIDTH), (float)(line * CHAR_HEIGHT * PIXEL_WIDTH));
-		m_screenWindow->draw(*m_charToDisplay);
+void Screen::drawCharacter(char c, uint8_t row, uint8_t line)
+{
+	if (c >= 32 && c <= 126 && row < SCREEN_CHAR_WIDTH && line < SCREEN_CHAR_HEIGHT) // ' ' is the first character to be displayable, '~' is the last
+	{
+		setCell(line * SCREEN_CHAR_WIDTH + row, c);
 	}
 }
 
 void Screen::clearScreen()
 {
-	m_screenWindow->clear(BACKGROUND_COLOR);
+	for (unsigned int i(0); i < SCREEN_CELLS_NB; i++)
+	{
+		setCell(i, 0);
+	}
 
-	refreshScreen();
+	refreshScreen(); // Shown without waiting for a refresh, as if the monitor was cleared
 }
 
 void Screen::refreshScreen()
 {
-	m_screenWindow->display();
+	bool dirty(false);
+
+	for (unsigned int i(0); i < SCREEN_DIRTY_WORDS; i++)
+	{
+		dirty |= (m_dirtyCells[i] != 0);
+	}
+
+	if (m_framePending)
+		m_coalescedRefreshes++;
+	else if (!dirty)
+		m_skippedRefreshes++;
+	else
+		m_framePending = true; // Presented at the end of the tick, or later if the last frame is too recent
+}
+
+bool Screen::setCell(unsigned int cell, char c)
+{
+	if (m_cells[cell] == c)
+		return false;
+
+	m_cells[cell] = c;
+	m_dirtyCells[cell / 64] |= (uint64_t)1 << (cell % 64);
+
+	return true;
 }
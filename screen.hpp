@@ -1,9 +1,9 @@
 #pragma once
 
-#include "keyboard.hpp"
-
-#define SCREEN_CHAR_WIDTH 40
-#define SCREEN_CHAR_HEIGHT 25
+#include "device.hpp"
+#include "display.hpp"
+#include "ram.hpp"
+#include "ringbuffer.hpp"
 
 #define CHAR_WIDTH 6
 #define CHAR_HEIGHT 8
@@ -16,30 +16,70 @@
 #define SCREEN_WIDTH SCREEN_WIDTH_PX * PIXEL_WIDTH
 #define SCREEN_HEIGHT SCREEN_HEIGHT_PX * PIXEL_WIDTH
 
-#define BACKGROUND_COLOR sf::Color(0, 0, 0, 255)
+#define SCREEN_COMMANDS_QUEUE_SIZE 64 // Commands written since the last tick, power of two
+#define SCREEN_MAX_FPS 60 // Presentations per second at most, the refreshes asked in between are merged
+
+#define VRAM_SIZE SCREEN_CELLS_NB // From VRAM_START_ADDRESS, line after line
+
+typedef struct
+{
+	uint8_t cmd;
+	char c; // Ports values when the command was written
+	uint8_t row;
+	uint8_t line;
+} ScreenCommand;
 
-class Screen : public Device
+class Screen : public Device, public MemoryWriteListener
 {
 	public:
-		Screen(Keyboard* k);
+		Screen(Display* display);
 		~Screen();
 
-		void tick();
+		CACHE_ALIGNED_NEW
+
+		void tick(); // Runs the commands written since the last tick
+
+		bool onPortWrite(uint8_t portNb); // Latches a command written in the CMD port
+
+		void presentIfDue(bool force = false); // Presents the pending frame once the frame interval is over, or at once if forced
+
+		// Text VRAM
+		void mapVRAM(RAM* ram); // From now on, the cells follow the writes into the VRAM window, without any refresh needed
+		void onMemoryWrite(uint32_t address);
+
+		// Getters
+		char getCharacter(uint8_t row, uint8_t line); // 0 if nothing is drawn there
+		const char* getCells(); // Line after line
+		uint64_t getPresentedFrames();
+		uint64_t getCoalescedRefreshes(); // Merged into a frame already pending
+		uint64_t getSkippedRefreshes(); // Nothing changed since the last frame
+
+		// Setters
+		void setMaxFPS(unsigned int fps); // 0 = no limit
 
 	private:
+		void runCommands();
 		void drawCharacter(char c, uint8_t row, uint8_t line);
 		void clearScreen();
 		void refreshScreen();
+		bool setCell(unsigned int cell, char c); // Returns false if the cell already holds this character
 
 		enum class Port { CHAR = 0, POS_X = 1, POS_Y = 2, CMD = 3 };
 		enum class Cmd { DRAW = 1, REFRESH = 2, CLEAR = 3 };
 
-		Keyboard* m_keyboard;
+		Display* m_display;
+		RAM* m_vram; // nullptr if the VRAM window isn't mapped
+
+		char m_cells[SCREEN_CELLS_NB]; // What the monitor shows, the display only presents it
+		uint64_t m_dirtyCells[SCREEN_DIRTY_WORDS]; // Changed since the last presentation
+
+		bool m_framePending; // Refresh asked, waiting for the end of the frame interval
+		std::chrono::steady_clock::duration m_frameInterval;
+		std::chrono::steady_clock::time_point m_lastPresentation;
 
-		sf::RenderWindow* m_screenWindow;
-		sf::Event* m_evt;
-		sf::RectangleShape* m_charToDisplay;
-		sf::Texture* m_characterMap, m_temp;
+		uint64_t m_presentedFrames;
+		uint64_t m_coalescedRefreshes;
+		uint64_t m_skippedRefreshes;
 
-		bool m_screenRefreshed;
+		RingBuffer<ScreenCommand, SCREEN_COMMANDS_QUEUE_SIZE> m_commands;
 };
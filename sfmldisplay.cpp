@@ -0,0 +1,90 @@
+#include "sfmldisplay.hpp"
+
+#ifndef HEADLESS
+
+SFMLDisplay::SFMLDisplay()
+{
+	m_screenWindow = new sf::RenderWindow(sf::VideoMode(SCREEN_WIDTH, SCREEN_HEIGHT), "HBC-2 Emulator - Monitor", sf::Style::Titlebar);
+	m_screenWindow->clear(BACKGROUND_COLOR);
+	m_screenWindow->display();
+	m_evt = new sf::Event();
+
+	m_characterMap = new sf::Texture();
+	m_characterMap->loadFromFile("ascii_character_map.png");
+
+	m_characters = new sf::VertexArray(sf::Quads, SCREEN_CELLS_NB * 4);
+
+	for (unsigned int i(0); i < SCREEN_CELLS_NB; i++)
+	{
+		setQuad(i, 0);
+	}
+
+	m_screenWindow->setActive(false); // The window is drawn by the emulation thread, which activates the context on its first draw
+}
+
+SFMLDisplay::~SFMLDisplay()
+{
+	delete m_evt;
+	delete m_characterMap;
+	delete m_characters;
+	delete m_screenWindow;
+}
+
+void SFMLDisplay::present(const char* cells, const uint64_t* dirtyCells)
+{
+	for (unsigned int word(0); word < SCREEN_DIRTY_WORDS; word++)
+	{
+		uint64_t dirty(dirtyCells[word]);
+
+		while (dirty != 0)
+		{
+			unsigned int cell(word * 64 + countTrailingZeros(dirty));
+
+			setQuad(cell, cells[cell]);
+
+			dirty &= dirty - 1; // Next dirty cell
+		}
+	}
+
+	m_screenWindow->clear(BACKGROUND_COLOR);
+	m_screenWindow->draw(*m_characters, sf::RenderStates(m_characterMap));
+	m_screenWindow->display();
+}
+
+// PRIVATE
+void SFMLDisplay::setQuad(unsigned int cell, char c)
+{
+	sf::Vertex* quad(&(*m_characters)[cell * 4]);
+	float posX((float)((cell % SCREEN_CHAR_WIDTH) * CHAR_WIDTH * PIXEL_WIDTH)), posY((float)((cell / SCREEN_CHAR_WIDTH) * CHAR_HEIGHT * PIXEL_WIDTH));
+	float width((float)(CHAR_WIDTH * PIXEL_WIDTH)), height((float)(CHAR_HEIGHT * PIXEL_WIDTH));
+
+	if (c == 0) // Nothing drawn, the quad is collapsed so the background shows through
+		width = height = 0.f;
+
+	c = (c >= 32) ? c - 32 : 0; // ' ' is the first character in the map
+
+	float texX((float)((c % 16) * CHAR_WIDTH)), texY((float)((c / 16) * CHAR_HEIGHT)); // 16 characters per line in the character map
+
+	quad[0] = sf::Vertex(sf::Vector2f(posX, posY), sf::Vector2f(texX, texY));
+	quad[1] = sf::Vertex(sf::Vector2f(posX + width, posY), sf::Vector2f(texX + CHAR_WIDTH, texY));
+	quad[2] = sf::Vertex(sf::Vector2f(posX + width, posY + height), sf::Vector2f(texX + CHAR_WIDTH, texY + CHAR_HEIGHT));
+	quad[3] = sf::Vertex(sf::Vector2f(posX, posY + height), sf::Vector2f(texX, texY + CHAR_HEIGHT));
+}
+
+bool SFMLDisplay::pollKeyEvent(uint8_t& keyCode, bool& pressed)
+{
+	while (m_screenWindow->pollEvent(*m_evt)) // It is the window that handles key hits in SFML, other events are discarded
+	{
+		if (m_evt->type == sf::Event::KeyPressed || m_evt->type == sf::Event::KeyReleased)
+		{
+			keyCode = (uint8_t)m_evt->key.code;
+			pressed = (m_evt->type == sf::Event::KeyPressed);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+#endif
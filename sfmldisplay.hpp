@@ -0,0 +1,30 @@
+#pragma once
+
+#ifndef HEADLESS
+
+#include "display.hpp"
+#include "screen.hpp"
+
+#define BACKGROUND_COLOR sf::Color(0, 0, 0, 255)
+
+// Monitor window rendered with SFML
+class SFMLDisplay : public Display
+{
+	public:
+		SFMLDisplay();
+		~SFMLDisplay();
+
+		void present(const char* cells, const uint64_t* dirtyCells); // One draw call for the whole screen
+
+		bool pollKeyEvent(uint8_t& keyCode, bool& pressed);
+
+	private:
+		sf::RenderWindow* m_screenWindow;
+		sf::Event* m_evt;
+		void setQuad(unsigned int cell, char c);
+
+		sf::VertexArray* m_characters; // A textured quad per cell, only the quads of the dirty cells are updated
+		sf::Texture* m_characterMap; // Glyph atlas
+};
+
+#endif
@@ -0,0 +1,277 @@
+#include "softwaredisplay.hpp"
+
+#include <fstream>
+#include <iomanip>
+
+// Copy of res/ascii_character_map.png, a byte per glyph line, most significant of the 6 bits on the left
+static const uint8_t BUILTIN_GLYPHS[GLYPHS_NB][CHAR_HEIGHT] =
+{
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+	{ 0x04, 0x0E, 0x0E, 0x04, 0x04, 0x00, 0x04, 0x00 }, // '!'
+	{ 0x1B, 0x1B, 0x12, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+	{ 0x00, 0x0A, 0x1F, 0x0A, 0x0A, 0x1F, 0x0A, 0x00 }, // '#'
+	{ 0x08, 0x0E, 0x10, 0x0C, 0x02, 0x1C, 0x04, 0x00 }, // '$'
+	{ 0x19, 0x19, 0x02, 0x04, 0x08, 0x13, 0x13, 0x00 }, // '%'
+	{ 0x08, 0x14, 0x14, 0x08, 0x15, 0x12, 0x0D, 0x00 }, // '&'
+	{ 0x0C, 0x0C, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '''
+	{ 0x04, 0x08, 0x08, 0x08, 0x08, 0x08, 0x04, 0x00 }, // '('
+	{ 0x08, 0x04, 0x04, 0x04, 0x04, 0x04, 0x08, 0x00 }, // ')'
+	{ 0x00, 0x0A, 0x0E, 0x1F, 0x0E, 0x0A, 0x00, 0x00 }, // '*'
+	{ 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00, 0x00 }, // '+'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x08 }, // ','
+	{ 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00, 0x00 }, // '-'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C, 0x00 }, // '.'
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00, 0x00 }, // '/'
+	{ 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E, 0x00 }, // '0'
+	{ 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00 }, // '1'
+	{ 0x0E, 0x11, 0x01, 0x06, 0x08, 0x10, 0x1F, 0x00 }, // '2'
+	{ 0x0E, 0x11, 0x01, 0x0E, 0x01, 0x11, 0x0E, 0x00 }, // '3'
+	{ 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02, 0x00 }, // '4'
+	{ 0x1F, 0x10, 0x10, 0x1E, 0x01, 0x11, 0x0E, 0x00 }, // '5'
+	{ 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E, 0x00 }, // '6'
+	{ 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08, 0x00 }, // '7'
+	{ 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E, 0x00 }, // '8'
+	{ 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C, 0x00 }, // '9'
+	{ 0x00, 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // ':'
+	{ 0x00, 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x08 }, // ';'
+	{ 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02, 0x00 }, // '<'
+	{ 0x00, 0x00, 0x1F, 0x00, 0x00, 0x1F, 0x00, 0x00 }, // '='
+	{ 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x00 }, // '>'
+	{ 0x0E, 0x11, 0x01, 0x06, 0x04, 0x00, 0x04, 0x00 }, // '?'
+	{ 0x0E, 0x11, 0x17, 0x15, 0x17, 0x10, 0x0E, 0x00 }, // '@'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x00 }, // 'A'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E, 0x00 }, // 'B'
+	{ 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E, 0x00 }, // 'C'
+	{ 0x1E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x1E, 0x00 }, // 'D'
+	{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F, 0x00 }, // 'E'
+	{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10, 0x00 }, // 'F'
+	{ 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F, 0x00 }, // 'G'
+	{ 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11, 0x00 }, // 'H'
+	{ 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x00 }, // 'I'
+	{ 0x01, 0x01, 0x01, 0x01, 0x11, 0x11, 0x0E, 0x00 }, // 'J'
+	{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11, 0x00 }, // 'K'
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F, 0x00 }, // 'L'
+	{ 0x11, 0x1B, 0x15, 0x11, 0x11, 0x11, 0x11, 0x00 }, // 'M'
+	{ 0x11, 0x19, 0x15, 0x13, 0x11, 0x11, 0x11, 0x00 }, // 'N'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00 }, // 'O'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10, 0x00 }, // 'P'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D, 0x00 }, // 'Q'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x12, 0x11, 0x11, 0x00 }, // 'R'
+	{ 0x0E, 0x11, 0x10, 0x0E, 0x01, 0x11, 0x0E, 0x00 }, // 'S'
+	{ 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x00 }, // 'T'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E, 0x00 }, // 'U'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00 }, // 'V'
+	{ 0x11, 0x11, 0x15, 0x15, 0x15, 0x15, 0x0A, 0x00 }, // 'W'
+	{ 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11, 0x00 }, // 'X'
+	{ 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x00 }, // 'Y'
+	{ 0x1E, 0x02, 0x04, 0x08, 0x10, 0x10, 0x1E, 0x00 }, // 'Z'
+	{ 0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E, 0x00 }, // '['
+	{ 0x00, 0x10, 0x08, 0x04, 0x02, 0x01, 0x00, 0x00 }, // backslash
+	{ 0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E, 0x00 }, // ']'
+	{ 0x04, 0x0A, 0x11, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '^'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F }, // '_'
+	{ 0x0C, 0x0C, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '`'
+	{ 0x00, 0x00, 0x0E, 0x01, 0x0F, 0x11, 0x0F, 0x00 }, // 'a'
+	{ 0x10, 0x10, 0x1E, 0x11, 0x11, 0x11, 0x1E, 0x00 }, // 'b'
+	{ 0x00, 0x00, 0x0E, 0x11, 0x10, 0x11, 0x0E, 0x00 }, // 'c'
+	{ 0x01, 0x01, 0x0F, 0x11, 0x11, 0x11, 0x0F, 0x00 }, // 'd'
+	{ 0x00, 0x00, 0x0E, 0x11, 0x1E, 0x10, 0x0E, 0x00 }, // 'e'
+	{ 0x06, 0x08, 0x08, 0x1E, 0x08, 0x08, 0x08, 0x00 }, // 'f'
+	{ 0x00, 0x00, 0x0F, 0x11, 0x11, 0x0F, 0x01, 0x0E }, // 'g'
+	{ 0x10, 0x10, 0x1C, 0x12, 0x12, 0x12, 0x12, 0x00 }, // 'h'
+	{ 0x04, 0x00, 0x04, 0x04, 0x04, 0x04, 0x06, 0x00 }, // 'i'
+	{ 0x02, 0x00, 0x06, 0x02, 0x02, 0x02, 0x12, 0x0C }, // 'j'
+	{ 0x10, 0x10, 0x12, 0x14, 0x18, 0x14, 0x12, 0x00 }, // 'k'
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x06, 0x00 }, // 'l'
+	{ 0x00, 0x00, 0x1A, 0x15, 0x15, 0x11, 0x11, 0x00 }, // 'm'
+	{ 0x00, 0x00, 0x1C, 0x12, 0x12, 0x12, 0x12, 0x00 }, // 'n'
+	{ 0x00, 0x00, 0x0E, 0x11, 0x11, 0x11, 0x0E, 0x00 }, // 'o'
+	{ 0x00, 0x00, 0x1E, 0x11, 0x11, 0x11, 0x1E, 0x10 }, // 'p'
+	{ 0x00, 0x00, 0x0F, 0x11, 0x11, 0x11, 0x0F, 0x01 }, // 'q'
+	{ 0x00, 0x00, 0x16, 0x09, 0x08, 0x08, 0x1C, 0x00 }, // 'r'
+	{ 0x00, 0x00, 0x0E, 0x10, 0x0E, 0x01, 0x0E, 0x00 }, // 's'
+	{ 0x00, 0x08, 0x1E, 0x08, 0x08, 0x0A, 0x04, 0x00 }, // 't'
+	{ 0x00, 0x00, 0x12, 0x12, 0x12, 0x16, 0x0A, 0x00 }, // 'u'
+	{ 0x00, 0x00, 0x11, 0x11, 0x11, 0x0A, 0x04, 0x00 }, // 'v'
+	{ 0x00, 0x00, 0x11, 0x11, 0x15, 0x1F, 0x0A, 0x00 }, // 'w'
+	{ 0x00, 0x00, 0x12, 0x12, 0x0C, 0x12, 0x12, 0x00 }, // 'x'
+	{ 0x00, 0x00, 0x12, 0x12, 0x12, 0x0E, 0x04, 0x18 }, // 'y'
+	{ 0x00, 0x00, 0x1E, 0x02, 0x0C, 0x10, 0x1E, 0x00 }, // 'z'
+	{ 0x06, 0x08, 0x08, 0x18, 0x08, 0x08, 0x06, 0x00 }, // '{'
+	{ 0x04, 0x04, 0x04, 0x00, 0x04, 0x04, 0x04, 0x00 }, // '|'
+	{ 0x0C, 0x02, 0x02, 0x03, 0x02, 0x02, 0x0C, 0x00 }, // '}'
+	{ 0x0A, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }  // '~'
+};
+
+static uint32_t rgba(uint8_t r, uint8_t g, uint8_t b, uint8_t a) // R G B A bytes in memory order, whatever the host endianness
+{
+	uint8_t bytes[4] = { r, g, b, a };
+	uint32_t pixel(0);
+
+	memcpy(&pixel, bytes, 4);
+
+	return pixel;
+}
+
+SoftwareDisplay::SoftwareDisplay() : m_framebuffer(SOFTWARE_FRAME_WIDTH * SOFTWARE_FRAME_HEIGHT)
+{
+	m_framesCount = 0;
+
+	loadGlyphs();
+
+	memset(m_cells, 0, sizeof(m_cells));
+
+	for (unsigned int i(0); i < SCREEN_CELLS_NB; i++)
+	{
+		blitCell(i, 0);
+	}
+}
+
+void SoftwareDisplay::present(const char* cells, const uint64_t* dirtyCells)
+{
+	for (unsigned int word(0); word < SCREEN_DIRTY_WORDS; word++)
+	{
+		uint64_t dirty(dirtyCells[word]);
+
+		while (dirty != 0)
+		{
+			unsigned int cell(word * 64 + countTrailingZeros(dirty));
+
+			m_cells[cell] = cells[cell];
+			blitCell(cell, cells[cell]);
+
+			dirty &= dirty - 1; // Next dirty cell
+		}
+	}
+
+	m_framesCount++;
+
+	if (!m_capturePrefix.empty())
+	{
+		std::ostringstream path;
+
+		path << m_capturePrefix << "_" << std::setw(6) << std::setfill('0') << m_framesCount << ".ppm";
+		saveFrame(path.str());
+	}
+}
+
+bool SoftwareDisplay::pollKeyEvent(uint8_t&, bool&)
+{
+	return false;
+}
+
+bool SoftwareDisplay::saveFrame(const std::string& path)
+{
+	std::ofstream file(path, std::ios::binary);
+	std::vector<uint8_t> rgb(SOFTWARE_FRAME_WIDTH * SOFTWARE_FRAME_HEIGHT * 3);
+
+	if (!file)
+		return false;
+
+	for (unsigned int i(0); i < SOFTWARE_FRAME_WIDTH * SOFTWARE_FRAME_HEIGHT; i++)
+	{
+		memcpy(&rgb[i * 3], &m_framebuffer[i], 3); // Alpha dropped
+	}
+
+	file << "P6\n" << SOFTWARE_FRAME_WIDTH << " " << SOFTWARE_FRAME_HEIGHT << "\n255\n";
+	file.write((const char*)rgb.data(), rgb.size());
+
+	return (bool)file;
+}
+
+bool SoftwareDisplay::saveCharacterGrid(const std::string& path)
+{
+	std::ofstream file(path);
+
+	if (!file)
+		return false;
+
+	for (unsigned int line(0); line < SCREEN_CHAR_HEIGHT; line++)
+	{
+		for (unsigned int row(0); row < SCREEN_CHAR_WIDTH; row++)
+		{
+			char c(m_cells[line * SCREEN_CHAR_WIDTH + row]);
+
+			file << ((c != 0) ? c : ' ');
+		}
+
+		file << '\n';
+	}
+
+	return (bool)file;
+}
+
+void SoftwareDisplay::setFramesCapture(const std::string& prefix)
+{
+	m_capturePrefix = prefix;
+}
+
+// GETTERS
+const uint32_t* SoftwareDisplay::getFramebuffer()
+{
+	return m_framebuffer.data();
+}
+
+uint64_t SoftwareDisplay::getFramesCount()
+{
+	return m_framesCount;
+}
+
+// PRIVATE
+void SoftwareDisplay::loadGlyphs()
+{
+	uint32_t foreground(rgba(255, 255, 255, 255)), background(rgba(0, 0, 0, 255)); // Colors of the character map
+
+#ifndef HEADLESS
+	sf::Image characterMap; // Decoded by the CPU, no graphics context needed
+
+	if (characterMap.loadFromFile("ascii_character_map.png") && characterMap.getSize().x >= 16 * CHAR_WIDTH && characterMap.getSize().y >= (GLYPHS_NB + 15) / 16 * CHAR_HEIGHT)
+	{
+		for (unsigned int g(0); g < GLYPHS_NB; g++)
+		{
+			for (unsigned int y(0); y < CHAR_HEIGHT; y++)
+			{
+				for (unsigned int x(0); x < CHAR_WIDTH; x++)
+				{
+					sf::Color color(characterMap.getPixel((g % 16) * CHAR_WIDTH + x, (g / 16) * CHAR_HEIGHT + y)); // 16 characters per line in the character map
+
+					m_glyphs[g][y][x] = rgba(color.r, color.g, color.b, color.a);
+				}
+			}
+		}
+	}
+	else
+#endif
+	{
+		for (unsigned int g(0); g < GLYPHS_NB; g++)
+		{
+			for (unsigned int y(0); y < CHAR_HEIGHT; y++)
+			{
+				for (unsigned int x(0); x < CHAR_WIDTH; x++)
+				{
+					m_glyphs[g][y][x] = (BUILTIN_GLYPHS[g][y] & (1 << (CHAR_WIDTH - 1 - x))) ? foreground : background;
+				}
+			}
+		}
+	}
+
+	for (unsigned int y(0); y < CHAR_HEIGHT; y++) // Empty cell
+	{
+		for (unsigned int x(0); x < CHAR_WIDTH; x++)
+		{
+			m_glyphs[GLYPHS_NB][y][x] = background;
+		}
+	}
+}
+
+void SoftwareDisplay::blitCell(unsigned int cell, char c)
+{
+	const uint32_t (*glyph)[CHAR_WIDTH](m_glyphs[(c >= 32 && c <= 126) ? c - 32 : GLYPHS_NB]);
+	uint32_t* destination(&m_framebuffer[(cell / SCREEN_CHAR_WIDTH) * CHAR_HEIGHT * SOFTWARE_FRAME_WIDTH + (cell % SCREEN_CHAR_WIDTH) * CHAR_WIDTH]);
+
+	for (unsigned int y(0); y < CHAR_HEIGHT; y++) // A fixed-size copy per glyph line, vectorized by the compiler
+	{
+		memcpy(destination, glyph[y], sizeof(glyph[y]));
+		destination += SOFTWARE_FRAME_WIDTH;
+	}
+}
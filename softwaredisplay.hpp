@@ -0,0 +1,39 @@
+#pragma once
+
+#include "display.hpp"
+#include "screen.hpp"
+
+#define GLYPHS_NB 95 // ' ' to '~'
+#define SOFTWARE_FRAME_WIDTH SCREEN_WIDTH_PX // One emulated pixel per framebuffer pixel
+#define SOFTWARE_FRAME_HEIGHT SCREEN_HEIGHT_PX
+
+// Monitor rendered by the CPU into an RGBA framebuffer, without any window nor graphics context (headless regression runs)
+class SoftwareDisplay : public Display
+{
+	public:
+		SoftwareDisplay();
+
+		void present(const char* cells, const uint64_t* dirtyCells); // Only the dirty cells are blitted again
+
+		bool pollKeyEvent(uint8_t& keyCode, bool& pressed); // Never any key hit
+
+		// Capture
+		bool saveFrame(const std::string& path); // Binary PPM of the last frame presented
+		bool saveCharacterGrid(const std::string& path); // Text file, a line per screen line, ' ' where nothing is drawn
+		void setFramesCapture(const std::string& prefix); // Every frame presented from now on is saved as <prefix>_<frame number>.ppm, empty = none
+
+		// Getters
+		const uint32_t* getFramebuffer(); // SOFTWARE_FRAME_WIDTH * SOFTWARE_FRAME_HEIGHT pixels, line after line, R G B A bytes in memory order
+		uint64_t getFramesCount();
+
+	private:
+		void loadGlyphs();
+		void blitCell(unsigned int cell, char c);
+
+		uint32_t m_glyphs[GLYPHS_NB + 1][CHAR_HEIGHT][CHAR_WIDTH]; // Expanded to RGBA so a glyph line is a single copy, the last one is the background
+		std::vector<uint32_t> m_framebuffer;
+		char m_cells[SCREEN_CELLS_NB]; // Content of the last frame
+
+		std::string m_capturePrefix;
+		uint64_t m_framesCount;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "defines.hpp"
+#include "alignednew.hpp"
+
+// Lock-free ring buffer shared by exactly one producer thread and one consumer thread
+// The indexes and the buffer are cache line aligned, a class that embeds it and is allocated with new needs CACHE_ALIGNED_NEW
+template <typename T, size_t N>
+class SPSCQueue
+{
+	static_assert(N >= 2 && (N & (N - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+	public:
+		SPSCQueue() : m_head(0), m_tail(0)
+		{
+
+		}
+
+		bool push(const T& value) // Producer side, returns false if the queue is full
+		{
+			size_t tail(m_tail.load(std::memory_order_relaxed));
+
+			if (tail - m_head.load(std::memory_order_acquire) >= N)
+				return false;
+
+			m_buffer[tail & (N - 1)] = value;
+			m_tail.store(tail + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool pop(T& value) // Consumer side, returns false if the queue is empty
+		{
+			size_t head(m_head.load(std::memory_order_relaxed));
+
+			if (head == m_tail.load(std::memory_order_acquire))
+				return false;
+
+			value = m_buffer[head & (N - 1)];
+			m_head.store(head + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		bool empty() const
+		{
+			return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+		}
+
+		size_t size() const
+		{
+			return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+		}
+
+	private:
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head; // Only written by the consumer
+		alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail; // Only written by the producer
+		alignas(CACHE_LINE_SIZE) T m_buffer[N];
+};